@@ -31,6 +31,7 @@ public class UtuPlugin : ModuleRules {
 				"Projects",
 				"InputCore",
 				"UnrealEd",
+				"EditorSubsystem",
 				"ToolMenus",
 				"LevelEditor",
 				"CoreUObject",
@@ -43,6 +44,7 @@ public class UtuPlugin : ModuleRules {
 				"Blutility",
 				"Json",
 				"JsonUtilities",
+				"ImageWrapper",
 				"AssetTools",
 				"AssetRegistry",
 				"KismetCompiler",
@@ -72,6 +74,16 @@ public class UtuPlugin : ModuleRules {
             );
         }
 
+        if (Target.Version.MajorVersion >= 5 && Target.Version.MinorVersion >= 1)
+        {
+            PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "DataLayerEditor"
+            }
+            );
+        }
+
         AddEngineThirdPartyPrivateStaticDependencies(Target, "FBX");
         //PrivateIncludePaths.Add("Editor/UnrealEd/Private");	//compatibility for FBX exporter
 
@@ -5,6 +5,7 @@
 #include "UtuPlugin/Core/Public/UtuPluginCommands.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginLibrary.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
 #include "Runtime/Launch/Resources/Version.h" 
 
 #include "Misc/MessageDialog.h"
@@ -51,6 +52,8 @@ void FUtuPluginModule::ShutdownModule()
 	FUtuPluginStyle::Shutdown();
 
 	FUtuPluginCommands::Unregister();
+
+	UUtuPluginLog::ShutdownLogWriter();
 }
 
 void FUtuPluginModule::PluginButtonClicked()
@@ -4,6 +4,10 @@
 #include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginLibrary.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginReport.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginImportEvents.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginCostModel.h"
 #include "Runtime/Launch/Resources/Version.h" 
 
 #include "Runtime/Core/Public/Misc/DateTime.h"
@@ -38,6 +42,9 @@ void FUtuPluginCurrentImport::BeginImport(FUtuPluginJson Json, TArray<EUtuAssetT
 	amountAssetTypesToProcess = assetTypesToProcess.Num();
 	percentAssetTypesToProcess = (float)countAssetTypesToProcess / (float)amountAssetTypesToProcess;
 	json = Json;
+	ImportCache = MakeShared<FUtuPluginImportCache>();
+	UtuPluginProfiling::BeginImport();
+	UtuPluginReport::BeginImport();
 	PopulateListOfDuplicatedAssetNames(Json);
 
 	timestamp = FDateTime::UtcNow().ToString().Replace(TEXT("-"), TEXT("_")).Replace(TEXT("."), TEXT(""));
@@ -80,7 +87,14 @@ void FUtuPluginCurrentImport::BeginImport(FUtuPluginJson Json, TArray<EUtuAssetT
 		UTU_LOG_L("        " + Property);
 	}
 
+	UtuPluginCostModel::BeginImport(json, assetTypesToProcess);
 	UTU_LOG_SEPARATOR_LINE();
+
+	int AssetCount = 0;
+	for (EUtuAssetType AssetType : assetTypesToProcess) {
+		AssetCount += GetAssetsNum(AssetType);
+	}
+	UUtuPluginImportEvents::NotifyImportStarted(assetTypesToProcess.Num(), AssetCount);
 }
 
 bool FUtuPluginCurrentImport::ContinueImport(bool executeFullImportOnSameFrame) 
@@ -96,7 +110,10 @@ bool FUtuPluginCurrentImport::ContinueImport(bool executeFullImportOnSameFrame)
 		currentAssetTypeProcessor = FUtuPluginAssetTypeProcessor();
 		currentAssetTypeProcessor.bIsValid = true;
 		currentAssetTypeProcessor.ImportSettings = UUtuPlugin::currentImportSettings;
+		currentAssetTypeProcessor.ImportCache = ImportCache;
 		nameUtuAssetTypesToProcess = AssetTypeToString(assetTypesToProcess[0]);
+		UtuPluginReport::BeginPhase(nameUtuAssetTypesToProcess);
+		UUtuPluginImportEvents::NotifyPhaseStarted(nameUtuAssetTypesToProcess, GetAssetsNum(assetTypesToProcess[0]));
 		currentAssetTypeProcessor.Import(json, assetTypesToProcess[0], executeFullImportOnSameFrame, ListOfDuplicatedAssetNames);
 		assetTypesToProcess.RemoveAt(0);
 		UTU_LOG_SEPARATOR_LINE();
@@ -108,6 +125,7 @@ bool FUtuPluginCurrentImport::ContinueImport(bool executeFullImportOnSameFrame)
 	if (executeFullImportOnSameFrame) 
 	{
 		currentAssetTypeProcessor.bIsValid = false;
+		UUtuPluginImportEvents::NotifyPhaseCompleted();
 		countAssetTypesToProcess = amountAssetTypesToProcess;
 		percentAssetTypesToProcess = (float)countAssetTypesToProcess / (float)FMath::Max(amountAssetTypesToProcess, 1);
 	}
@@ -116,6 +134,7 @@ bool FUtuPluginCurrentImport::ContinueImport(bool executeFullImportOnSameFrame)
 		if (currentAssetTypeProcessor.ContinueImport()) 
 		{
 			currentAssetTypeProcessor.bIsValid = false;
+			UUtuPluginImportEvents::NotifyPhaseCompleted();
 			countAssetTypesToProcess++;
 			percentAssetTypesToProcess = (float)countAssetTypesToProcess / (float)FMath::Max(amountAssetTypesToProcess, 1);
 			countAssetProcessedForSave++;
@@ -126,7 +145,10 @@ bool FUtuPluginCurrentImport::ContinueImport(bool executeFullImportOnSameFrame)
 				TArray<UPackage*> Packages;
 				FEditorFileUtils::GetDirtyContentPackages(Packages);
 				FEditorFileUtils::GetDirtyWorldPackages(Packages);
+				UTU_TRACE_SCOPE("UtuPlugin::SaveAll");
+				double SaveStartTime = FPlatformTime::Seconds();
 				FEditorFileUtils::PromptForCheckoutAndSave(Packages, false, false);
+				UUtuPluginLog::AddSaveEvent(Packages.Num(), FPlatformTime::Seconds() - SaveStartTime);
 			}
 		}
 	}
@@ -158,7 +180,10 @@ void FUtuPluginCurrentImport::CompleteImport() {
 		TArray<UPackage*> Packages;
 		FEditorFileUtils::GetDirtyContentPackages(Packages);
 		FEditorFileUtils::GetDirtyWorldPackages(Packages);
+		UTU_TRACE_SCOPE("UtuPlugin::SaveAll");
+		double SaveStartTime = FPlatformTime::Seconds();
 		FEditorFileUtils::PromptForCheckoutAndSave(Packages, false, false);
+		UUtuPluginLog::AddSaveEvent(Packages.Num(), FPlatformTime::Seconds() - SaveStartTime);
 	}
 	UTU_LOG_SEPARATOR_LINE();
 	UTU_LOG_L("Import Completed!");
@@ -169,8 +194,18 @@ void FUtuPluginCurrentImport::CompleteImport() {
 	UUtuPluginLog::GetLogState(LogState, WarningCount, ErrorCount);
 	UTU_LOG("    Warning Count: " + FString::FromInt(WarningCount), WarningCount > 0 ? EUtuLog::Warning : EUtuLog::Log);
 	UTU_LOG("    Error   Count: " + FString::FromInt(ErrorCount), ErrorCount > 0 ? EUtuLog::Error : EUtuLog::Log);
+	if (UUtuPlugin::currentImportSettings.bWriteImportReport)
+	{
+		FString JsonPath, DummyName, DummyExtension;
+		FPaths::Split(json.json_info.json_file_fullname, JsonPath, DummyName, DummyExtension);
+		UtuPluginReport::WriteReport(JsonPath, UUtuPlugin::currentImportSettings.ReportSlowestAssetCount);
+		UTU_LOG_L("    Report: " + JsonPath + UtuPluginPaths::slash + "UnrealImportReport.html");
+	}
 	UTU_LOG_SEPARATOR_LINE();
 	UUtuPluginLog::PrintIntoLogFile("", true);
+	UtuPluginProfiling::CompleteImport();
+	UtuPluginCostModel::CompleteImport();
+	UUtuPluginImportEvents::NotifyImportCompleted(false);
 }
 
 FString FUtuPluginCurrentImport::AssetTypeToString(EUtuAssetType AssetType) {
@@ -200,13 +235,39 @@ FString FUtuPluginCurrentImport::AssetTypeToString(EUtuAssetType AssetType) {
 	return "";
 }
 
+int FUtuPluginCurrentImport::GetAssetsNum(EUtuAssetType AssetType) {
+	switch (AssetType) {
+	case EUtuAssetType::Scene:
+		return json.scenes.Num();
+	case EUtuAssetType::Mesh:
+		return json.meshes.Num();
+	case EUtuAssetType::Animation:
+		return json.animations.Num();
+	case EUtuAssetType::Material:
+		return json.materials.Num();
+	case EUtuAssetType::Texture:
+		return json.textures.Num();
+	case EUtuAssetType::PrefabFirstPass:
+		return json.prefabs_first_pass.Num();
+	case EUtuAssetType::PrefabSecondPass:
+		return json.prefabs_second_pass.Num();
+	default:
+		break;
+	}
+	return 0;
+}
+
+double FUtuPluginCurrentImport::EstimateNextAssetSeconds() {
+	return currentAssetTypeProcessor.bIsValid ? currentAssetTypeProcessor.EstimateNextAssetSeconds() : 0.0;
+}
+
 
 void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson Json)
 {
 	ListOfDuplicatedAssetNames.Empty();
 
 	FUtuPluginAssetTypeProcessor Proc = FUtuPluginAssetTypeProcessor();
-	TArray<FString> UniqueNames = TArray<FString>();
+	TSet<FString> UniqueNames;
 
 	// Find all duplicated names
 	if (UUtuPlugin::currentImportSettings.Scenes.AssetRenameSettings.bAutoRenameDuplicatedAssets)
@@ -218,7 +279,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 			{
 				ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 			}
-			UniqueNames.AddUnique(AssetNames[2]);
+			UniqueNames.Add(AssetNames[2]);
 		}
 	}
 	for (FUtuPluginMesh Asset : Json.meshes)
@@ -232,7 +293,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 				{
 					ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 				}
-				UniqueNames.AddUnique(AssetNames[2]);
+				UniqueNames.Add(AssetNames[2]);
 			}
 		}
 		else
@@ -244,7 +305,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 				{
 					ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 				}
-				UniqueNames.AddUnique(AssetNames[2]);
+				UniqueNames.Add(AssetNames[2]);
 			}
 		}
 	}
@@ -257,7 +318,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 			{
 				ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 			}
-			UniqueNames.AddUnique(AssetNames[2]);
+			UniqueNames.Add(AssetNames[2]);
 		}
 	}
 	if (UUtuPlugin::currentImportSettings.Materials.AssetRenameSettings.bAutoRenameDuplicatedAssets)
@@ -269,7 +330,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 			{
 				ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 			}
-			UniqueNames.AddUnique(AssetNames[2]);
+			UniqueNames.Add(AssetNames[2]);
 		}
 	}
 	if (UUtuPlugin::currentImportSettings.Textures.AssetRenameSettings.bAutoRenameDuplicatedAssets)
@@ -281,7 +342,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 			{
 				ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 			}
-			UniqueNames.AddUnique(AssetNames[2]);
+			UniqueNames.Add(AssetNames[2]);
 		}
 	}
 	if (UUtuPlugin::currentImportSettings.Blueprints.AssetRenameSettings.bAutoRenameDuplicatedAssets)
@@ -293,7 +354,7 @@ void FUtuPluginCurrentImport::PopulateListOfDuplicatedAssetNames(FUtuPluginJson
 			{
 				ListOfDuplicatedAssetNames.Add(AssetNames[2]);
 			}
-			UniqueNames.AddUnique(AssetNames[2]);
+			UniqueNames.Add(AssetNames[2]);
 		}
 	}
 }
@@ -355,17 +416,29 @@ bool UUtuPlugin::IsGarbageCollecting()
 	return GIsGarbageCollecting;
 }
 
-FUtuPluginCurrentImport UUtuPlugin::ContinueCurrentImport() {
+void UUtuPlugin::ContinueCurrentImport() {
 	if (currentImportJob.bIsValid) {
 		if (currentImportJob.ContinueImport(false)) {
 			currentImportJob.bIsValid = false;
 		}
 	}
-	return currentImportJob;
+}
+
+void UUtuPlugin::ContinueCurrentImportWithinBudget(double BudgetSeconds) {
+	double StartTime = FPlatformTime::Seconds();
+	do {
+		ContinueCurrentImport();
+	} while (currentImportJob.bIsValid && FPlatformTime::Seconds() - StartTime + currentImportJob.EstimateNextAssetSeconds() <= BudgetSeconds);
 }
 
 void UUtuPlugin::CancelImport() {
+	if (currentImportJob.currentAssetTypeProcessor.bIsValid) {
+		currentImportJob.currentAssetTypeProcessor.CancelImport(); // Don't leave the materials processed so far uncompiled
+	}
 	currentImportJob.bIsValid = false;
+	UtuPluginProfiling::CompleteImport();
+	UtuPluginCostModel::CompleteImport(); // Keep the timings of what was done
+	UUtuPluginImportEvents::NotifyImportCompleted(true);
 	UUtuPluginLog::PrintIntoLogFile("\n\n\n\n\n\nImport Cancelled By User!", true);
 }
 
@@ -373,7 +446,12 @@ void FTick::Tick(float DeltaTime) {
 	static int TickCount = 0; // To give enough time to the user to cancel
 	TickCount++;
 	if (TickCount == 10) {
-		UUtuPlugin::ContinueCurrentImport();
+		if (UUtuPlugin::currentImportSettings.TickTimeBudgetMs > 0.0f) {
+			UUtuPlugin::ContinueCurrentImportWithinBudget(UUtuPlugin::currentImportSettings.TickTimeBudgetMs / 1000.0);
+		}
+		else {
+			UUtuPlugin::ContinueCurrentImport();
+		}
 		TickCount = 0;
 	}
 }
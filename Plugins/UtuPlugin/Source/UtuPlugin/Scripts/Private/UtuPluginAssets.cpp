@@ -4,6 +4,8 @@
 #include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginConstants.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginCostModel.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginLibrary.h"
 
 #include "Developer/AssetTools/Public/IAssetTools.h"
@@ -45,11 +47,24 @@
 #include "Engine/SkinnedAssetCommon.h"
 #endif
 
+#if ENGINE_MAJOR_VERSION >= 5
+#include "WorldPartition/WorldPartition.h"
+#endif
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/WorldDataLayers.h"
+#include "DataLayer/DataLayerEditorSubsystem.h"
+#endif
+
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "Runtime/Engine/Public/ComponentReregisterContext.h"
+#include "Runtime/Engine/Public/MaterialShared.h"
+#include "Runtime/Engine/Public/ShaderCompiler.h"
 #include "Editor/UnrealEd/Classes/Factories/FbxImportUI.h"
 #include "Editor/UnrealEd/Classes/Factories/FbxStaticMeshImportData.h"
 #include "Editor/UnrealEd/Classes/Factories/FbxSkeletalMeshImportData.h"
@@ -60,6 +75,8 @@
 #include "Editor/KismetCompiler/Public/KismetCompilerModule.h"
 #include "Runtime/Engine/Classes/Engine/SimpleConstructionScript.h"
 #include "Runtime/Engine/Classes/Engine/SCS_Node.h"
+#include "Runtime/Engine/Classes/Engine/BlueprintGeneratedClass.h"
+#include "Runtime/Engine/Classes/Engine/Level.h"
 #include "Runtime/Engine/Classes/Animation/AnimSequence.h"
 //#include "Editor/UnrealEd/Public/Toolkits/AssetEditorManager.h"
 //#include "Editor/Kismet/Public/BlueprintEditor.h"
@@ -82,6 +99,8 @@
 #include "Runtime/Engine/Classes/Components/DirectionalLightComponent.h"
 #include "Runtime/Engine/Classes/Components/SkyLightComponent.h"
 #include "Runtime/Engine/Classes/Components/SkeletalMeshComponent.h"
+#include "Runtime/Engine/Classes/Components/InstancedStaticMeshComponent.h"
+#include "Runtime/Engine/Classes/Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Runtime/CinematicCamera/Public/CineCameraActor.h"
 #include "Runtime/CinematicCamera/Public/CineCameraComponent.h"
 #include "Runtime/Engine/Classes/Camera/CameraActor.h"
@@ -92,6 +111,11 @@
 #include "Materials/MaterialExpressionMultiply.h"
 #include "Materials/MaterialExpressionPanner.h"
 #include "Materials/MaterialExpressionTextureCoordinate.h"
+#include "Materials/MaterialExpressionParameter.h"
+#include "Materials/MaterialExpressionTextureSampleParameter.h"
+#include "Materials/MaterialExpressionOneMinus.h"
+#include "Async/ParallelFor.h"
+#include "Misc/SecureHash.h"
 #include "Engine/TextureCube.h"
 #include "MaterialEditingLibrary.h"
 
@@ -106,6 +130,7 @@
 #include "UObject/GCObjectScopeGuard.h"
 #include "Exporters/Exporter.h"
 #include "UnrealExporter.h"
+#include "JsonObjectConverter.h"
 
 void FUtuPluginAssetTypeProcessor::Import(FUtuPluginJson Json, EUtuAssetType AssetType, bool executeFullImportOnSameFrame, TArray<FString> DuplicatedAssetNames) {
 	BeginImport(Json, AssetType, DuplicatedAssetNames);
@@ -118,6 +143,10 @@ void FUtuPluginAssetTypeProcessor::Import(FUtuPluginJson Json, EUtuAssetType Ass
 
 void FUtuPluginAssetTypeProcessor::BeginImport(FUtuPluginJson Json, EUtuAssetType AssetType, TArray<FString> DuplicatedAssetNames) {
 	AssetTools = FModuleManager::LoadModulePtr<FAssetToolsModule>("AssetTools");
+	if (!ImportCache.IsValid())
+	{
+		ImportCache = MakeShared<FUtuPluginImportCache>();
+	}
 	
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
 	UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
@@ -130,6 +159,27 @@ void FUtuPluginAssetTypeProcessor::BeginImport(FUtuPluginJson Json, EUtuAssetTyp
 	json = Json;
 	assetType = AssetType;
 	ListOfDuplicatedAssetNames = DuplicatedAssetNames;
+	ImportStartTime = FPlatformTime::Seconds();
+	if (ImportSettings.Textures.bDeduplicateTextures && !ImportCache->bTextureRedirectsBuilt)
+	{
+		BuildTextureRedirects();
+	}
+	if (ImportSettings.Materials.bDeduplicateMaterialInstances && ImportSettings.Materials.bCreateMaterialInstances)
+	{
+		BuildMaterialRedirects();
+	}
+	if (assetType == EUtuAssetType::Material && ImportSettings.Materials.bPackOrmTextures && ImportSettings.Materials.bCreateMaterialInstances)
+	{
+		BuildPackedOrmTextures();
+	}
+	for (const FUtuPluginPrefabFirstPass& PrefabFirstPass : json.prefabs_first_pass)
+	{
+		PrefabsHaveStaticChild.Add(PrefabFirstPass.asset_relative_filename, PrefabFirstPass.has_any_static_child);
+	}
+	if (assetType == EUtuAssetType::Texture && ImportSettings.Textures.NonPowerOfTwoBehavior != EUtuNonPowerOfTwoBehavior::KeepAsIs)
+	{
+		BuildUnpaddableTextures();
+	}
 	amountItemsToProcess = GetAssetsNum();
 	countItemsToProcess = 1;
 	percentItemsToProcess = (float)countItemsToProcess / (float)amountItemsToProcess;
@@ -139,11 +189,14 @@ void FUtuPluginAssetTypeProcessor::BeginImport(FUtuPluginJson Json, EUtuAssetTyp
 }
 
 bool FUtuPluginAssetTypeProcessor::ContinueImport() {
+	UTU_TRACE_SCOPE("UtuPlugin::ContinueImport");
 	if (GetAssetsNum() == 0) {
 		//UTU_LOG_E("FUtuPluginAssetTypeProcessor::ContinueImport() Was called even though the list is already empty. This should never happen!");
 		CompleteImport();
 		return true;
 	}
+	double AssetStartTime = FPlatformTime::Seconds();
+	double AssetUnits = UtuPluginCostModel::GetAssetUnits(json, assetType, 0);
 	switch (assetType) {
 	case EUtuAssetType::Scene:
 		nameItemToProcess = json.scenes[0].asset_name;
@@ -183,6 +236,33 @@ bool FUtuPluginAssetTypeProcessor::ContinueImport() {
 	default:
 		break;
 	}
+	UtuPluginCostModel::CompleteAsset(assetType, AssetUnits, FPlatformTime::Seconds() - AssetStartTime);
+	UUtuPluginLog::EndAssetEvent();
+	INC_DWORD_STAT(STAT_UtuPlugin_AssetsProcessed);
+	float AssetsPerSecond = countItemsToProcess / FMath::Max(FPlatformTime::Seconds() - ImportStartTime, 0.001);
+	switch (assetType) {
+	case EUtuAssetType::Scene:
+		SET_FLOAT_STAT(STAT_UtuPlugin_ScenesPerSecond, AssetsPerSecond);
+		break;
+	case EUtuAssetType::Animation:
+		SET_FLOAT_STAT(STAT_UtuPlugin_AnimationsPerSecond, AssetsPerSecond);
+		break;
+	case EUtuAssetType::Mesh:
+		SET_FLOAT_STAT(STAT_UtuPlugin_MeshesPerSecond, AssetsPerSecond);
+		break;
+	case EUtuAssetType::Material:
+		SET_FLOAT_STAT(STAT_UtuPlugin_MaterialsPerSecond, AssetsPerSecond);
+		break;
+	case EUtuAssetType::Texture:
+		SET_FLOAT_STAT(STAT_UtuPlugin_TexturesPerSecond, AssetsPerSecond);
+		break;
+	case EUtuAssetType::PrefabFirstPass:
+	case EUtuAssetType::PrefabSecondPass:
+		SET_FLOAT_STAT(STAT_UtuPlugin_PrefabsPerSecond, AssetsPerSecond);
+		break;
+	default:
+		break;
+	}
 	countItemsToProcess++;
 	percentItemsToProcess = (float)countItemsToProcess / (float)FMath::Max(amountItemsToProcess, 1);
 	if (GetAssetsNum() == 0) {
@@ -194,6 +274,37 @@ bool FUtuPluginAssetTypeProcessor::ContinueImport() {
 
 void FUtuPluginAssetTypeProcessor::CompleteImport() 
 {
+	UUtuPluginLog::EndAssetEvent();
+	UUtuPluginLog::SetLogContext("");
+	FlushDeferredMaterials();
+	if ((assetType == EUtuAssetType::Texture || assetType == EUtuAssetType::Mesh) && ImportSettings.Textures.bTexelDensityAnalysis)
+	{
+		AnalyzeTexelDensity();
+	}
+	if (assetType == EUtuAssetType::Texture && ImportCache->NonPowerOfTwoTextures.Num() > 0)
+	{
+		UTU_LOG_L("Non Power Of Two Textures: " + FString::FromInt(ImportCache->NonPowerOfTwoTextures.Num()));
+		for (FString Texture : ImportCache->NonPowerOfTwoTextures)
+		{
+			UTU_LOG_L("    " + Texture);
+		}
+	}
+	if (assetType == EUtuAssetType::Texture && ImportCache->TextureRedirects.Num() > 0)
+	{
+		UTU_LOG_L("Texture Deduplication: " + FString::FromInt(ImportCache->TextureRedirects.Num()) + " duplicated textures not imported, " + FString::SanitizeFloat(ImportCache->TextureRedirectsSavedBytes / (1024.0 * 1024.0)) + " MB of source files saved.");
+		UTU_LOG_L("    Texture import time: " + FString::SanitizeFloat(FPlatformTime::Seconds() - ImportStartTime) + " seconds.");
+	}
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+	UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
+	InterchangeManager.SetInterchangeImportEnabled(bWasInterchangeEnabled);
+#endif
+}
+
+void FUtuPluginAssetTypeProcessor::CancelImport() 
+{
+	UUtuPluginLog::EndAssetEvent();
+	UUtuPluginLog::SetLogContext("");
+	FlushDeferredMaterials();
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
 	UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
 	InterchangeManager.SetInterchangeImportEnabled(bWasInterchangeEnabled);
@@ -278,6 +389,7 @@ void FUtuPluginAssetTypeProcessor::CopyUtuAssetsInProject()
 
 
 TArray<FString> FUtuPluginAssetTypeProcessor::FormatRelativeFilenameForUnreal(FString InRelativeFilename, EUtuUnrealAssetType AssetType) {
+	UTU_TRACE_SCOPE("UtuPlugin::FormatRelativeFilenameForUnreal");
 	if (InRelativeFilename != "") 
 	{
 		FString Relative = InRelativeFilename;
@@ -394,6 +506,7 @@ TArray<FString> FUtuPluginAssetTypeProcessor::FormatRelativeFilenameForUnreal(FS
 
 TArray<FString> FUtuPluginAssetTypeProcessor::FormatRelativeFilenameForUnrealSeparated(FString InRelativeFilename, FString InRelativeFilenameSeparated, EUtuUnrealAssetType AssetType)
 {
+	UTU_TRACE_SCOPE("UtuPlugin::FormatRelativeFilenameForUnrealSeparated");
 	TArray<FString> RelativeNames = FormatRelativeFilenameForUnreal(InRelativeFilename, AssetType);
 	TArray<FString> RelativeNamesSeparated = FormatRelativeFilenameForUnreal(InRelativeFilenameSeparated, AssetType);
 
@@ -446,7 +559,15 @@ int FUtuPluginAssetTypeProcessor::GetAssetsNum() {
 	return 0;
 }
 
+double FUtuPluginAssetTypeProcessor::EstimateNextAssetSeconds() {
+	if (GetAssetsNum() == 0) {
+		return 0.0;
+	}
+	return UtuPluginCostModel::EstimateSeconds(assetType, UtuPluginCostModel::GetAssetUnits(json, assetType, 0));
+}
+
 void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessScene");
 	// Format Paths
 	TArray<FString> AssetNames = StartProcessAsset(InUtuScene, EUtuUnrealAssetType::Level);
 	// Invalid Asset
@@ -459,10 +580,12 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 		if (ImportSettings.Scenes.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else if (Asset != nullptr && ImportSettings.Scenes.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else
 		{
@@ -471,36 +594,165 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 			{
 				UPackage* Package = CreateAssetPackage(AssetNames[2], true);
 				UWorldFactory* Factory = NewObject<UWorldFactory>();
+#if ENGINE_MAJOR_VERSION >= 5
+				Factory->bCreateWorldPartition = ImportSettings.Scenes.bCreateWorldPartition;
+#endif
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+				Factory->bEnableWorldPartitionStreaming = ImportSettings.Scenes.bCreateWorldPartition;
+#endif
 				Asset = Cast<UWorld>(Factory->FactoryCreateNew(UWorld::StaticClass(), Package, FName(*AssetNames[1]), RF_Public | RF_Standalone, NULL, GWarn));
 				LogAssetImportedOrFailed(Asset, AssetNames, "", "World", { });
 			}
+#if ENGINE_MAJOR_VERSION >= 5
+			else if (ImportSettings.Scenes.bCreateWorldPartition && Asset->GetWorldPartition() == nullptr)
+			{
+				UTU_LOG_W("        'bCreateWorldPartition' is ignored because the level already exists and is not a World Partition level.");
+				UTU_LOG_W("            Potential Causes:");
+				UTU_LOG_W("                - The level was created by a previous import without 'bCreateWorldPartition'. Delete it and import again.");
+			}
+#endif
 			// Process Asset
 			if (Asset != nullptr)
 			{
 				Asset->PreEditChange(NULL);
-				// Delete Old Actors -- TODO : Analyse them and keep the good ones
+				// Batch Spawning
+				bIsBatchSpawning = ImportSettings.Scenes.bBatchSpawnActors;
+				if (bIsBatchSpawning)
+				{
+					UTU_LOG_L("        Batch spawning enabled. Spawned actors will be constructed and registered once every actor is in place.");
+				}
+				// Old Actors
 				TArray<AActor*> OldActors;
 				UGameplayStatics::GetAllActorsWithTag(Asset, "UtuActor", OldActors);
-				if (OldActors.Num() > 0) 
+				TMap<int, AActor*> OldIdToActor;
+				TMap<FString, AActor*> OldInstancesGroups;
+				TSet<AActor*> OldInstancesGroupsActors;
+				TSet<AActor*> KeptActors;
+				AActor* OldSkyLight = nullptr;
+				if (OldActors.Num() > 0 && ImportSettings.Scenes.bDiffReimport)
+				{
+					UTU_LOG_L("        " + FString::FromInt(OldActors.Num()) + " old actors from previous import detected. Comparing them with the new scene...");
+					for (AActor* OldActor : OldActors)
+					{
+						int OldId = GetActorUtuId(OldActor);
+						if (OldActor->Tags.Contains("UtuInstances"))
+						{
+							OldInstancesGroups.Add(GetActorTagValue(OldActor, "UtuGroup_"), OldActor);
+							OldInstancesGroupsActors.Add(OldActor);
+						}
+						else if (OldId != UtuConst::INVALID_INT)
+						{
+							OldIdToActor.Add(OldId, OldActor);
+						}
+						else if (OldSkyLight == nullptr && OldActor->IsA<ASkyLight>())
+						{
+							OldSkyLight = OldActor;
+							KeptActors.Add(OldActor);
+						}
+					}
+					// Keep the actors that can be updated in place
+					for (const FUtuPluginActor& UtuActor : InUtuScene.scene_actors)
+					{
+						AActor** OldActor = OldIdToActor.Find(UtuActor.actor_id);
+						if (OldActor != nullptr && GetActorTagValue(*OldActor, "UtuSig_") == WorldGetActorSignature(UtuActor))
+						{
+							KeptActors.Add(*OldActor);
+						}
+					}
+					// Actors spawned as part of another one (prefabs replaced by meshes) follow their parent
+					for (AActor* OldActor : OldActors)
+					{
+						if (!KeptActors.Contains(OldActor) && GetActorUtuId(OldActor) == UtuConst::INVALID_INT && KeptActors.Contains(OldActor->GetAttachParentActor()) && !OldActor->Tags.Contains("UtuInstances"))
+						{
+							KeptActors.Add(OldActor);
+						}
+					}
+				}
+				// Delete Old Actors
+				int DeletedActorsCount = 0;
+				for (AActor* OldActor : OldActors) 
 				{
-					UTU_LOG_L("        " + FString::FromInt(OldActors.Num()) + " old actors from previous import detected. Deleting them...");
-					//UTU_LOG_L("            Plan for a future release: Analyse existing Actors and keep the good ones.");
-					for (AActor* OldActor : OldActors) {
+					if (!KeptActors.Contains(OldActor) && !OldInstancesGroupsActors.Contains(OldActor))
+					{
+						// Sub actors of a root actor are not tagged
+						TArray<AActor*> AttachedActors;
+						OldActor->GetAttachedActors(AttachedActors);
+						for (AActor* AttachedActor : AttachedActors)
+						{
+							if (!AttachedActor->Tags.Contains("UtuActor"))
+							{
+								Asset->DestroyActor(AttachedActor);
+							}
+						}
 						Asset->DestroyActor(OldActor);
+						DeletedActorsCount++;
 					}
 				}
+				if (DeletedActorsCount > 0)
+				{
+					UTU_LOG_L("        " + FString::FromInt(DeletedActorsCount) + " old actors from previous import deleted.");
+				}
 				// Start by creating a simple SkyLight
-				WorldSpawnSkyLightActor(Asset);
+				if (OldSkyLight == nullptr)
+				{
+					WorldSpawnSkyLightActor(Asset);
+				}
 				// Map
 				TMap<int, AActor*> IdToActor;
 				TMap<AActor*, int> ActorToParentId;
+				// Instanced Actors
+				TSet<int> InstancedIds;
+				if (ImportSettings.Scenes.bInstanceStaticMeshActors)
+				{
+					InstancedIds = WorldSpawnInstancedStaticMeshActors(Asset, InUtuScene.scene_actors, IdToActor, ActorToParentId, OldInstancesGroups);
+				}
+				for (const TPair<FString, AActor*>& OldGroup : OldInstancesGroups)
+				{
+					Asset->DestroyActor(OldGroup.Value);
+				}
+				// Old standalone actors that are now part of an instance group
+				for (int InstancedId : InstancedIds)
+				{
+					AActor** OldActor = OldIdToActor.Find(InstancedId);
+					if (OldActor != nullptr && KeptActors.Contains(*OldActor))
+					{
+						TArray<AActor*> AttachedActors;
+						(*OldActor)->GetAttachedActors(AttachedActors);
+						for (AActor* AttachedActor : AttachedActors)
+						{
+							if (!AttachedActor->Tags.Contains("UtuActor"))
+							{
+								KeptActors.Remove(AttachedActor);
+								Asset->DestroyActor(AttachedActor);
+							}
+						}
+						KeptActors.Remove(*OldActor);
+						Asset->DestroyActor(*OldActor);
+						DeletedActorsCount++;
+					}
+				}
 				// Spawn Actors
+				int UpdatedActorsCount = 0;
 				for (FUtuPluginActor UtuActor : InUtuScene.scene_actors) 
 				{
+					if (InstancedIds.Contains(UtuActor.actor_id))
+					{
+						continue;
+					}
+					AActor** OldActor = OldIdToActor.Find(UtuActor.actor_id);
+					if (OldActor != nullptr && KeptActors.Contains(*OldActor))
+					{
+						WorldUpdateExistingActor(*OldActor, UtuActor);
+						IdToActor.Add(UtuActor.actor_id, *OldActor);
+						ActorToParentId.Add(*OldActor, UtuActor.actor_parent_id);
+						UpdatedActorsCount++;
+						continue;
+					}
 					AActor* RootActor = WorldAddRootActorForSubActorsIfNeeded(Asset, UtuActor);
 					if (RootActor != nullptr) 
 					{
 						RootActor->Tags.Add("UtuActor");
+						RootActor->Tags.Add(*("UtuSig_" + WorldGetActorSignature(UtuActor)));
 						IdToActor.Add(UtuActor.actor_id, RootActor);
 						ActorToParentId.Add(RootActor, UtuActor.actor_parent_id);
 					}
@@ -550,15 +802,16 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 								Actor->Tags.Add("UtuActor");
 								Actor->SetActorLabel(UtuActor.actor_display_name);
 								Actor->Tags.Add(*FString::FromInt(UtuActor.actor_id));
+								Actor->Tags.Add(*("UtuId_" + FString::FromInt(UtuActor.actor_id)));
 								if (UtuActor.actor_tag != "Untagged") 
 								{
 									Actor->Tags.Add(*UtuActor.actor_tag);
 								}
+								Actor->Tags.Add(*("UtuSig_" + WorldGetActorSignature(UtuActor)));
+								Actor->Tags.Add(*("UtuMeshSig_" + WorldGetActorMeshSignature(UtuActor)));
 								Actor->SetActorHiddenInGame(!UtuActor.actor_is_visible);
 								Actor->GetRootComponent()->SetVisibility(UtuActor.actor_is_visible, true);
-								Actor->SetActorLocation(UtuConst::ConvertLocation(UtuActor.actor_world_location));
-								Actor->SetActorRotation(UtuConst::ConvertRotation(UtuActor.actor_world_rotation));
-								Actor->SetActorScale3D(UtuConst::ConvertScale(UtuActor.actor_world_scale));
+								Actor->SetActorTransform(FTransform(UtuConst::ConvertRotation(UtuActor.actor_world_rotation), UtuConst::ConvertLocation(UtuActor.actor_world_location), UtuConst::ConvertScale(UtuActor.actor_world_scale)));
 								IdToActor.Add(UtuActor.actor_id, Actor);
 								ActorToParentId.Add(Actor, UtuActor.actor_parent_id);
 							}
@@ -581,8 +834,11 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 						if (IdToActor.Contains(Id)) 
 						{
 							AActor* ParentActor = IdToActor[Id];
-							Actor->AttachToActor(ParentActor, FAttachmentTransformRules(EAttachmentRule::KeepWorld, false));
-							UTU_LOG_L("            " + Actor->GetActorLabel() + " -> " + ParentActor->GetActorLabel());
+							if (Actor->GetAttachParentActor() != ParentActor)
+							{
+								Actor->AttachToActor(ParentActor, FAttachmentTransformRules(EAttachmentRule::KeepWorld, false));
+								UTU_LOG_L("            " + Actor->GetActorLabel() + " -> " + ParentActor->GetActorLabel());
+							}
 						}
 						else {
 							UTU_LOG_W("            Failed to find parent for: " + Actor->GetActorLabel());
@@ -592,9 +848,47 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 							UTU_LOG_W("                    - The desired parent failed to spawn for some reason. (Missing Bp asset maybe?)");
 						}
 					}
+					else if (KeptActors.Contains(Actor) && Actor->GetAttachParentActor() != nullptr)
+					{
+						Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+					}
+				}
+				// Finish Deferred Actors
+				if (bIsBatchSpawning)
+				{
+					UTU_LOG_L("        Registering components of " + FString::FromInt(BatchSpawnedActors.Num()) + " spawned actors...");
+					for (AActor* DeferredActor : DeferredSpawnedActors)
+					{
+						if (IsValid(DeferredActor))
+						{
+							DeferredActor->FinishSpawning(DeferredActor->GetActorTransform(), true);
+						}
+					}
+					// Only the new actors, the actors already in the level are left registered
+					for (AActor* SpawnedActor : BatchSpawnedActors)
+					{
+						if (IsValid(SpawnedActor))
+						{
+							SpawnedActor->RegisterAllComponents();
+						}
+					}
+					DeferredSpawnedActors.Empty();
+					BatchSpawnedActors.Empty();
+					bIsBatchSpawning = false;
+				}
+				// World Partition
+				if (ImportSettings.Scenes.bCreateWorldPartition)
+				{
+					WorldSetupWorldPartition(Asset, InUtuScene.scene_actors, IdToActor);
+				}
+				if (ImportSettings.Scenes.bDiffReimport)
+				{
+					UTU_LOG_L("        Scene reimport summary:");
+					UTU_LOG_L("            Actors updated in place: " + FString::FromInt(UpdatedActorsCount));
+					UTU_LOG_L("            Actors deleted: " + FString::FromInt(DeletedActorsCount));
 				}
 				Asset->MarkPackageDirty();
-				Asset->PostEditChange();
+				UTU_EVENT_STAGE(EUtuEventStage::PostEdit, Asset->PostEditChange());
 			}
 		}
 	}
@@ -602,6 +896,7 @@ void FUtuPluginAssetTypeProcessor::ProcessScene(FUtuPluginScene InUtuScene) {
 
 void FUtuPluginAssetTypeProcessor::ProcessAnimation(FUtuPluginAnimation InUtuAnimation)
 {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessAnimation");
 	// Format Paths
 	TArray<FString> AssetNames = StartProcessAsset(InUtuAnimation, EUtuUnrealAssetType::Animation);
 	TArray<FString> AssetNames_Anim = TArray<FString>({ AssetNames[0], AssetNames[1] + "_Anim", AssetNames[0] + "/" + AssetNames[1] + "_Anim" });
@@ -618,10 +913,12 @@ void FUtuPluginAssetTypeProcessor::ProcessAnimation(FUtuPluginAnimation InUtuAni
 		if (ImportSettings.Animations.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else if (Asset != nullptr && ImportSettings.Animations.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else
 		{
@@ -697,7 +994,7 @@ void FUtuPluginAssetTypeProcessor::ProcessAnimation(FUtuPluginAnimation InUtuAni
 						}
 
 						// Process
-						AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuAnimation.animation_file_absolute_filename, CustomAssetNames, Options) });
+						UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuAnimation.animation_file_absolute_filename, CustomAssetNames, Options) }));
 						Asset = Cast<UAnimSequence>(UUtuPluginLibrary::TryGetAsset(CustomAssetNames[2]));
 						LogAssetImportedOrFailed(Asset, CustomAssetNames, InUtuAnimation.animation_file_absolute_filename, "Animation", { "Invalid FBX : Make sure that the Fbx file is valid by trying to import it manually in Unreal." });
 					}
@@ -714,7 +1011,7 @@ void FUtuPluginAssetTypeProcessor::ProcessAnimation(FUtuPluginAnimation InUtuAni
 					Options->bResetToFbxOnMaterialConflict = true;
 
 					// Process
-					AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuAnimation.animation_file_absolute_filename, AssetNames, Options) });
+					UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuAnimation.animation_file_absolute_filename, AssetNames, Options) }));
 					Asset = Cast<UAnimSequence>(UUtuPluginLibrary::TryGetAsset(AssetNames_Anim[2]));
 					LogAssetImportedOrFailed(Asset, AssetNames_Anim, InUtuAnimation.animation_file_absolute_filename, "Animation", { "Invalid FBX : Make sure that the Fbx file is valid by trying to import it manually in Unreal." });
 				}
@@ -725,6 +1022,7 @@ void FUtuPluginAssetTypeProcessor::ProcessAnimation(FUtuPluginAnimation InUtuAni
 
 
 void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessMesh");
 	if (InUtuMesh.asset_relative_filename.StartsWith("Assets") || InUtuMesh.asset_relative_filename.StartsWith("Packages")) { // Default Unity Mesh
 		// Format Paths
 		TArray<FString> AssetNames = StartProcessAsset(InUtuMesh, InUtuMesh.is_skeletal_mesh ? EUtuUnrealAssetType::SkeletalMesh : EUtuUnrealAssetType::StaticMesh);
@@ -738,10 +1036,12 @@ void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
 				if (ImportSettings.SkeletalMeshes.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else if (Asset != nullptr && ImportSettings.SkeletalMeshes.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else
 				{
@@ -789,7 +1089,7 @@ void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
 						}
 
 						// Process
-						AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, AssetNames, Options) });
+						UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, AssetNames, Options) }));
 
 						Asset = Cast<USkeletalMesh>(UUtuPluginLibrary::TryGetAsset(AssetNames[2]));
 						LogAssetImportedOrFailed(Asset, AssetNames, InUtuMesh.mesh_file_absolute_filename, "SkeletalMesh", { "Invalid FBX : Make sure that the Fbx file is valid by trying to import it manually in Unreal." });
@@ -816,10 +1116,12 @@ void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
 				if (ImportSettings.StaticMeshes.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else if (Asset != nullptr && ImportSettings.StaticMeshes.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else
 				{
@@ -852,7 +1154,7 @@ void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
 						}
 
 						// Process
-						AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, AssetNames, Options) });
+						UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, AssetNames, Options) }));
 
 						// Check if worked
 						Asset = GetMeshAsset(AssetNames);
@@ -956,7 +1258,7 @@ void FUtuPluginAssetTypeProcessor::ProcessMesh(FUtuPluginMesh InUtuMesh) {
 											FbxImportData->ImportTranslation = DesiredOptions->StaticMeshImportData->ImportTranslation;
 											FbxImportData->ImportRotation = DesiredOptions->StaticMeshImportData->ImportRotation;
 											FbxImportData->ImportUniformScale = DesiredOptions->StaticMeshImportData->ImportUniformScale;
-											AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, SubMeshAssetNames, DesiredOptions) });
+											UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuMesh.mesh_file_absolute_filename, SubMeshAssetNames, DesiredOptions) }));
 											//FReimportManager::Instance()->Reimport(SubAsset);
 										}
 									}
@@ -1139,7 +1441,14 @@ UPackage* FUtuPluginAssetTypeProcessor::CreateAssetPackage(FString InRelativeFil
 }
 
 void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMaterial) {
-	if (!InUtuMaterial.asset_relative_filename.StartsWith("Resources")) // Default Unity Material
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessMaterial");
+	if (MaterialRedirects.Contains(InUtuMaterial.asset_relative_filename)) // Deduplicated Material
+	{
+		StartProcessAsset(InUtuMaterial, EUtuUnrealAssetType::MaterialInstance);
+		UTU_LOG_L("        Asset skipped because it is identical to: '" + MaterialRedirects[InUtuMaterial.asset_relative_filename] + "'");
+		UUtuPluginLog::SetAssetEventOutcome("Deduplicated");
+	}
+	else if (!InUtuMaterial.asset_relative_filename.StartsWith("Resources")) // Default Unity Material
 	{
 		// Format Paths
 		TArray<FString> AssetNames = StartProcessAsset(InUtuMaterial, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
@@ -1155,10 +1464,12 @@ void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMater
 				if (ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else if (Asset != nullptr && ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else
 				{
@@ -1176,111 +1487,19 @@ void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMater
 
 						if (Asset != nullptr)
 						{
-							Asset->MarkPackageDirty();
-
-							// Parent
-							Asset->SetParentEditorOnly(ParentMaterial, true);
-
-							// Clear everything
-							Asset->ClearParameterValuesEditorOnly();
-
-							// Two Sided
-							Asset->BasePropertyOverrides.bOverride_TwoSided = true;
-							Asset->BasePropertyOverrides.TwoSided = InUtuMaterial.two_sided;
-
-							// Blend Mode
-							Asset->BasePropertyOverrides.bOverride_BlendMode = true;
-							switch (InUtuMaterial.shader_opacity)
-							{
-							default:
-								break;
-							case EUtuShaderOpacity::Opaque:
-								Asset->BasePropertyOverrides.BlendMode = EBlendMode::BLEND_Opaque;
-								break;
-							case EUtuShaderOpacity::Masked:
-								Asset->BasePropertyOverrides.BlendMode = EBlendMode::BLEND_Masked;
-								break;
-							case EUtuShaderOpacity::Translucent:
-								Asset->BasePropertyOverrides.BlendMode = EBlendMode::BLEND_Translucent;
-								break;
-							}
-
-							// Settings
-							if (ImportSettings.Materials.bOverrideMetallicIntensityMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_MetallicIntensityMultiplier"), ImportSettings.Materials.MetallicIntensityMultiplier);
-							if (ImportSettings.Materials.bOverrideSpecularIntensityMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_SpecularIntensityMultiplier"), ImportSettings.Materials.SpecularIntensityMultiplier);
-							if (ImportSettings.Materials.bOverrideEmissiveIntensityMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_EmissiveIntensityMultiplier"), ImportSettings.Materials.EmissiveIntensityMultiplier);
-							if (ImportSettings.Materials.bOverrideNormalIntensityMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_NormalIntensityMultiplier"), ImportSettings.Materials.NormalIntensityMultiplier);
-							if (ImportSettings.Materials.bOverrideOcclusionIntensityMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_OcclusionIntensityMultiplier"), ImportSettings.Materials.OcclusionIntensityMultiplier);
-							if (ImportSettings.Materials.bOverrideTexturesPannerTime)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_TexturesPannerTime"), ImportSettings.Materials.TexturesPannerTime);
-							if (ImportSettings.Materials.bOverrideRoughnessMultiplier)
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_RoughnessMultiplier"), ImportSettings.Materials.RoughnessMultiplier);
-
-							// Main color and texture for custom shaders
-							UTexture2D* MainTextureAsset = GetTextureFromUnityRelativeFilename(InUtuMaterial.main_texture);
-							if (MainTextureAsset != nullptr)
-								Asset->SetTextureParameterValueEditorOnly(FName("__Main_Texture"), MainTextureAsset);
-							Asset->SetScalarParameterValueEditorOnly(FName("Utu_TexturesPannerTime___Main_Texture"), ImportSettings.Materials.TexturesPannerTime);
-							Asset->SetVectorParameterValueEditorOnly(FName("__Main_Color"), HexToColor(InUtuMaterial.main_color));
-
-							// Floats
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_floats_names.Num(), InUtuMaterial.material_floats.Num()); Idx++)
-							{
-								FString Name = InUtuMaterial.material_floats_names[Idx];
-								float Value = InUtuMaterial.material_floats[Idx];
-								Asset->SetScalarParameterValueEditorOnly(*Name, Value);
-							}
-
-							// Textures
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
-							{
-								FString Name = InUtuMaterial.material_textures_names[Idx];
-								UTexture2D* Value = GetTextureFromUnityRelativeFilename(InUtuMaterial.material_textures[Idx]);
-								if (Value != nullptr)
-								{
-									Asset->SetTextureParameterValueEditorOnly(*Name, Value);
-								}
-								Asset->SetScalarParameterValueEditorOnly(FName("Utu_TexturesPannerTime_" + Name), ImportSettings.Materials.TexturesPannerTime);
-							}
-
-							// Colors
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_colors_names.Num(), InUtuMaterial.material_colors.Num()); Idx++)
-							{
-								FString Name = InUtuMaterial.material_colors_names[Idx];
-								FLinearColor Value = HexToColor(InUtuMaterial.material_colors[Idx]);
-								Asset->SetVectorParameterValueEditorOnly(*Name, Value);
-							}
-
-							// Vectors
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vectors_names.Num(), InUtuMaterial.material_vectors.Num()); Idx++)
-							{
-								FString Name = InUtuMaterial.material_vectors_names[Idx];
-								FQuat Value = InUtuMaterial.material_vectors[Idx];
-								Asset->SetVectorParameterValueEditorOnly(*Name, FLinearColor(Value.X, Value.Y, Value.Z, Value.W));
-							}
-
-							// Vector2s
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vector2s_names.Num(), InUtuMaterial.material_vector2s.Num()); Idx++)
+							FUtuMaterialInstanceTarget Target = BuildMaterialInstanceTarget(InUtuMaterial, ParentMaterial);
+							ApplyPackedOrmTexture(InUtuMaterial, Target);
+							ApplyVirtualTextures(Target);
+							ApplyPaddedTextureScale(Target);
+							if (ApplyMaterialInstanceTarget(Asset, Target))
 							{
-								FString Name = InUtuMaterial.material_vector2s_names[Idx];
-								FVector2D Value = InUtuMaterial.material_vector2s[Idx];
-								Asset->SetVectorParameterValueEditorOnly(*Name, FLinearColor(Value.X, Value.Y, 0.0f, 0.0f));
+								Asset->MarkPackageDirty();
+								MaterialPostEditChange(Asset);
 							}
-
-							// Ints
-							for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_ints_names.Num(), InUtuMaterial.material_ints.Num()); Idx++)
+							else
 							{
-								FString Name = InUtuMaterial.material_ints_names[Idx];
-								int Value = InUtuMaterial.material_ints[Idx];
-								Asset->SetScalarParameterValueEditorOnly(*Name, Value);
+								UTU_LOG_L("        Material instance is already up to date. Nothing to recompile.");
 							}
-
-							Asset->PostEditChange();
 						}
 					}
 					else
@@ -1301,10 +1520,12 @@ void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMater
 				if (ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else if (MatAsset != nullptr && ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 				{
 					UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+					UUtuPluginLog::SetAssetEventOutcome("Skipped");
 				}
 				else
 				{
@@ -1415,7 +1636,23 @@ void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMater
 							MatAsset->SetScalarParameterValueEditorOnly(*Name, Value);
 						}
 
-						MatAsset->PostEditChange();
+						// Virtual Textures
+						TSet<FName> VirtualParameterNames;
+						for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
+						{
+							UTexture2D* Value = GetTextureFromUnityRelativeFilename(InUtuMaterial.material_textures[Idx]);
+							if (Value != nullptr && Value->VirtualTextureStreaming)
+							{
+								VirtualParameterNames.Add(*InUtuMaterial.material_textures_names[Idx]);
+							}
+						}
+						if (MainTextureAsset != nullptr && MainTextureAsset->VirtualTextureStreaming)
+						{
+							VirtualParameterNames.Add("__Main_Texture");
+						}
+						SetVirtualSamplers(MatAsset, VirtualParameterNames, false);
+
+						MaterialPostEditChange(MatAsset);
 					}
 				}
 			}
@@ -1423,103 +1660,772 @@ void FUtuPluginAssetTypeProcessor::ProcessMaterial(FUtuPluginMaterial InUtuMater
 	}
 }
 
-UMaterial* FUtuPluginAssetTypeProcessor::GetOrCreateParentMaterial(FUtuPluginMaterial InUtuMaterial)
+FUtuMaterialInstanceTarget FUtuPluginAssetTypeProcessor::BuildMaterialInstanceTarget(FUtuPluginMaterial InUtuMaterial, UMaterial* InParentMaterial)
 {
-	FString MatName = InUtuMaterial.shader_name;
-	MatName = MatName.Replace(TEXT(" "), TEXT(""));
-	MatName = MatName.Replace(TEXT("."), TEXT("_"));
-	MatName = MatName.Replace(TEXT("/"), TEXT("_"));
-	MatName = MatName.Replace(TEXT("("), TEXT(""));
-	MatName = MatName.Replace(TEXT(")"), TEXT(""));
+	FUtuMaterialInstanceTarget Target;
+	// Parent
+	Target.Parent = InParentMaterial;
 
-	// Default material (Supported materials)
-	FString MatDir = "/Game/Utu/Shaders/";
-	FString MatPath = MatDir + MatName;
-	UMaterial* Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
-	if (Material != nullptr)
+	// Two Sided
+	Target.bTwoSided = InUtuMaterial.two_sided;
+
+	// Blend Mode
+	switch (InUtuMaterial.shader_opacity)
 	{
-		UTU_LOG_L("        Parent Material: \"" + MatPath + "\"");
-		return Material;
+	default:
+		break;
+	case EUtuShaderOpacity::Opaque:
+		Target.bHasBlendMode = true;
+		Target.BlendMode = EBlendMode::BLEND_Opaque;
+		break;
+	case EUtuShaderOpacity::Masked:
+		Target.bHasBlendMode = true;
+		Target.BlendMode = EBlendMode::BLEND_Masked;
+		break;
+	case EUtuShaderOpacity::Translucent:
+		Target.bHasBlendMode = true;
+		Target.BlendMode = EBlendMode::BLEND_Translucent;
+		break;
 	}
 
-	// Custom material (Unsupported materials)
-	MatDir = "/Game/Utu/CustomShaders/";
-	MatPath = MatDir + MatName;
-	Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
-	if (Material != nullptr)
+	// Settings
+	if (ImportSettings.Materials.bOverrideMetallicIntensityMultiplier)
+		Target.Scalars.Add(FName("Utu_MetallicIntensityMultiplier"), ImportSettings.Materials.MetallicIntensityMultiplier);
+	if (ImportSettings.Materials.bOverrideSpecularIntensityMultiplier)
+		Target.Scalars.Add(FName("Utu_SpecularIntensityMultiplier"), ImportSettings.Materials.SpecularIntensityMultiplier);
+	if (ImportSettings.Materials.bOverrideEmissiveIntensityMultiplier)
+		Target.Scalars.Add(FName("Utu_EmissiveIntensityMultiplier"), ImportSettings.Materials.EmissiveIntensityMultiplier);
+	if (ImportSettings.Materials.bOverrideNormalIntensityMultiplier)
+		Target.Scalars.Add(FName("Utu_NormalIntensityMultiplier"), ImportSettings.Materials.NormalIntensityMultiplier);
+	if (ImportSettings.Materials.bOverrideOcclusionIntensityMultiplier)
+		Target.Scalars.Add(FName("Utu_OcclusionIntensityMultiplier"), ImportSettings.Materials.OcclusionIntensityMultiplier);
+	if (ImportSettings.Materials.bOverrideTexturesPannerTime)
+		Target.Scalars.Add(FName("Utu_TexturesPannerTime"), ImportSettings.Materials.TexturesPannerTime);
+	if (ImportSettings.Materials.bOverrideRoughnessMultiplier)
+		Target.Scalars.Add(FName("Utu_RoughnessMultiplier"), ImportSettings.Materials.RoughnessMultiplier);
+
+	// Main color and texture for custom shaders
+	UTexture2D* MainTextureAsset = GetTextureFromUnityRelativeFilename(InUtuMaterial.main_texture);
+	if (MainTextureAsset != nullptr)
+		Target.Textures.Add(FName("__Main_Texture"), MainTextureAsset);
+	Target.Scalars.Add(FName("Utu_TexturesPannerTime___Main_Texture"), ImportSettings.Materials.TexturesPannerTime);
+	Target.Vectors.Add(FName("__Main_Color"), HexToColor(InUtuMaterial.main_color));
+
+	// Floats
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_floats_names.Num(), InUtuMaterial.material_floats.Num()); Idx++)
 	{
-		UTU_LOG_L("        Parent Material: \"" + MatPath + "\"");
-		return Material;
+		Target.Scalars.Add(*InUtuMaterial.material_floats_names[Idx], InUtuMaterial.material_floats[Idx]);
 	}
 
-	// Create custom material
-	UTU_LOG_W("        No Supported Material Found. Creating Custom Material: \"" + MatPath + "\" ...");
-	if (ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
+	// Textures
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
 	{
-		UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
-		return nullptr;
+		FString Name = InUtuMaterial.material_textures_names[Idx];
+		UTexture2D* Value = GetTextureFromUnityRelativeFilename(InUtuMaterial.material_textures[Idx]);
+		if (Value != nullptr)
+		{
+			Target.Textures.Add(*Name, Value);
+		}
+		Target.Scalars.Add(FName("Utu_TexturesPannerTime_" + Name), ImportSettings.Materials.TexturesPannerTime);
 	}
 
-	UPackage* Package = CreateAssetPackage(MatPath, false);
-	NewObject<UMaterialFactoryNew>()->FactoryCreateNew(UMaterial::StaticClass(), Package, FName(*MatName), RF_Public | RF_Standalone, NULL, GWarn);
-	Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
-	LogAssetImportedOrFailed(Material, { MatDir, MatName, MatPath }, "", "Material", { });
+	// Colors
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_colors_names.Num(), InUtuMaterial.material_colors.Num()); Idx++)
+	{
+		Target.Vectors.Add(*InUtuMaterial.material_colors_names[Idx], HexToColor(InUtuMaterial.material_colors[Idx]));
+	}
 
-	// Process Material
-	if (Material != nullptr)
+	// Vectors
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vectors_names.Num(), InUtuMaterial.material_vectors.Num()); Idx++)
 	{
-		UTU_LOG_L("        Building Material...");
-		Material->PreEditChange(NULL);
-		Material->GetOutermost()->FullyLoad();
-		Material->MarkPackageDirty();
+		FQuat Value = InUtuMaterial.material_vectors[Idx];
+		Target.Vectors.Add(*InUtuMaterial.material_vectors_names[Idx], FLinearColor(Value.X, Value.Y, Value.Z, Value.W));
+	}
 
-		int H = -2000;
-		int V = 700;
-		// Settings
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.MetallicIntensityMultiplier, "Utu_MetallicIntensityMultiplier", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.SpecularIntensityMultiplier, "Utu_SpecularIntensityMultiplier", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.EmissiveIntensityMultiplier, "Utu_EmissiveIntensityMultiplier", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.NormalIntensityMultiplier, "Utu_NormalIntensityMultiplier", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.OcclusionIntensityMultiplier, "Utu_OcclusionIntensityMultiplier", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.TexturesPannerTime, "Utu_TexturesPannerTime", H, V, InUtuMaterial);
-		H += 300;
-		GetOrCreateScalarParameter(Material, ImportSettings.Materials.RoughnessMultiplier, "Utu_RoughnessMultiplier", H, V, InUtuMaterial);
+	// Vector2s
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vector2s_names.Num(), InUtuMaterial.material_vector2s.Num()); Idx++)
+	{
+		FVector2D Value = InUtuMaterial.material_vector2s[Idx];
+		Target.Vectors.Add(*InUtuMaterial.material_vector2s_names[Idx], FLinearColor(Value.X, Value.Y, 0.0f, 0.0f));
+	}
 
+	// Ints
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_ints_names.Num(), InUtuMaterial.material_ints.Num()); Idx++)
+	{
+		Target.Scalars.Add(*InUtuMaterial.material_ints_names[Idx], InUtuMaterial.material_ints[Idx]);
+	}
+	return Target;
+}
 
-		H = -2000;
-		V = 1000;
-		// Floats
-		for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_floats_names.Num(), InUtuMaterial.material_floats.Num()); Idx++)
-		{
-			FString Name = InUtuMaterial.material_floats_names[Idx];
-			float Value = InUtuMaterial.material_floats[Idx];
-			UMaterialExpressionScalarParameter* Scalar = GetOrCreateScalarParameter(Material, Value, *Name, H, V, InUtuMaterial);
-			H += 300;
-		}
+bool FUtuPluginAssetTypeProcessor::ApplyMaterialInstanceTarget(UMaterialInstanceConstant* InAsset, const FUtuMaterialInstanceTarget& InTarget)
+{
+	bool bChanged = false;
 
-		H = -2000;
-		V = 1300;
-		// Textures & Panners
-		for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
-		{
-			FString Name = InUtuMaterial.material_textures_names[Idx];
-			UTexture2D* Value = GetTextureFromUnityRelativeFilename(InUtuMaterial.material_textures[Idx]);
-			UMaterialExpressionTextureSampleParameter2D* Texture = GetOrCreateTextureParameter(Material, Value, *Name, H + 600, V, InUtuMaterial);
+	// Parent
+	if (InAsset->Parent != InTarget.Parent)
+	{
+		InAsset->SetParentEditorOnly(InTarget.Parent, true);
+		bChanged = true;
+	}
 
-			int TexCoordIndex = InUtuMaterial.material_vector2s_names.Find(Name + "_ST_TexCoord");
-			int PannerIndex = InUtuMaterial.material_vector2s_names.Find(Name + "_ST_Panner");
-			if (TexCoordIndex >= 0 && PannerIndex >= 0)
-			{
-				FString TexCoordName = InUtuMaterial.material_vector2s_names[TexCoordIndex];
-				FVector2D TexCoordValue = FVector2D(1.0f);
-				if (InUtuMaterial.material_vector2s.IsValidIndex(TexCoordIndex))
-				{
-					TexCoordValue = InUtuMaterial.material_vector2s[TexCoordIndex];
+	// Existing values
+	TMap<FName, float> ExistingScalars;
+	for (const FScalarParameterValue& Parameter : InAsset->ScalarParameterValues)
+	{
+		ExistingScalars.Add(Parameter.ParameterInfo.Name, Parameter.ParameterValue);
+	}
+	TMap<FName, FLinearColor> ExistingVectors;
+	for (const FVectorParameterValue& Parameter : InAsset->VectorParameterValues)
+	{
+		ExistingVectors.Add(Parameter.ParameterInfo.Name, Parameter.ParameterValue);
+	}
+	TMap<FName, UTexture*> ExistingTextures;
+	for (const FTextureParameterValue& Parameter : InAsset->TextureParameterValues)
+	{
+		ExistingTextures.Add(Parameter.ParameterInfo.Name, Parameter.ParameterValue);
+	}
+
+	// Clear everything only if some values must go away
+	bool bHasStaleValues = InAsset->RuntimeVirtualTextureParameterValues.Num() > 0 || InAsset->FontParameterValues.Num() > 0
+		|| ExistingScalars.Num() != InAsset->ScalarParameterValues.Num() || ExistingVectors.Num() != InAsset->VectorParameterValues.Num() || ExistingTextures.Num() != InAsset->TextureParameterValues.Num();
+	for (const TPair<FName, float>& Existing : ExistingScalars)
+	{
+		bHasStaleValues |= !InTarget.Scalars.Contains(Existing.Key);
+	}
+	for (const TPair<FName, FLinearColor>& Existing : ExistingVectors)
+	{
+		bHasStaleValues |= !InTarget.Vectors.Contains(Existing.Key);
+	}
+	for (const TPair<FName, UTexture*>& Existing : ExistingTextures)
+	{
+		bHasStaleValues |= !InTarget.Textures.Contains(Existing.Key);
+	}
+	if (bHasStaleValues)
+	{
+		InAsset->ClearParameterValuesEditorOnly();
+		ExistingScalars.Empty();
+		ExistingVectors.Empty();
+		ExistingTextures.Empty();
+		bChanged = true;
+	}
+
+	// Two Sided
+	if (!InAsset->BasePropertyOverrides.bOverride_TwoSided || InAsset->BasePropertyOverrides.TwoSided != InTarget.bTwoSided)
+	{
+		InAsset->BasePropertyOverrides.bOverride_TwoSided = true;
+		InAsset->BasePropertyOverrides.TwoSided = InTarget.bTwoSided;
+		bChanged = true;
+	}
+
+	// Blend Mode
+	if (!InAsset->BasePropertyOverrides.bOverride_BlendMode || (InTarget.bHasBlendMode && InAsset->BasePropertyOverrides.BlendMode != InTarget.BlendMode))
+	{
+		InAsset->BasePropertyOverrides.bOverride_BlendMode = true;
+		if (InTarget.bHasBlendMode)
+		{
+			InAsset->BasePropertyOverrides.BlendMode = InTarget.BlendMode;
+		}
+		bChanged = true;
+	}
+
+	// Values
+	for (const TPair<FName, float>& Parameter : InTarget.Scalars)
+	{
+		const float* Existing = ExistingScalars.Find(Parameter.Key);
+		if (Existing == nullptr || *Existing != Parameter.Value)
+		{
+			InAsset->SetScalarParameterValueEditorOnly(Parameter.Key, Parameter.Value);
+			bChanged = true;
+		}
+	}
+	for (const TPair<FName, FLinearColor>& Parameter : InTarget.Vectors)
+	{
+		const FLinearColor* Existing = ExistingVectors.Find(Parameter.Key);
+		if (Existing == nullptr || *Existing != Parameter.Value)
+		{
+			InAsset->SetVectorParameterValueEditorOnly(Parameter.Key, Parameter.Value);
+			bChanged = true;
+		}
+	}
+	for (const TPair<FName, UTexture*>& Parameter : InTarget.Textures)
+	{
+		UTexture* const* Existing = ExistingTextures.Find(Parameter.Key);
+		if (Existing == nullptr || *Existing != Parameter.Value)
+		{
+			InAsset->SetTextureParameterValueEditorOnly(Parameter.Key, Parameter.Value);
+			bChanged = true;
+		}
+	}
+	return bChanged;
+}
+
+void FUtuPluginAssetTypeProcessor::BuildPackedOrmTextures()
+{
+	struct FUtuOrmPackJob
+	{
+		UTexture2D* Metallic = nullptr;
+		UTexture2D* Occlusion = nullptr;
+		FString MetallicFilename;
+		FString OcclusionFilename;
+		FString Hash;
+		FString AssetPath;
+		bool bNeedsPacking = false;
+		bool bValid = false;
+		TArray64<uint8> MetallicData;
+		TArray64<uint8> OcclusionData;
+		int32 MetallicSize[2] = { 0, 0 };
+		int32 OcclusionSize[2] = { 0, 0 };
+		bool bMetallicG8 = false;
+		bool bOcclusionG8 = false;
+		TArray64<uint8> Packed;
+		int32 Width = 0;
+		int32 Height = 0;
+	};
+
+	UTU_LOG_SEPARATOR_LINE();
+	UTU_LOG_L("Packing ORM textures...");
+	OrmTextures.Empty();
+	TMap<FString, FString> TextureFilenames;
+	for (const FUtuPluginTexture& UtuTexture : json.textures)
+	{
+		TextureFilenames.Add(UtuTexture.asset_relative_filename, UtuTexture.texture_file_absolute_filename);
+	}
+
+	// One job per unique metallic/occlusion pair
+	TArray<FUtuOrmPackJob> Jobs;
+	TMap<FString, int> PairToJob;
+	TMap<FString, int> MaterialToJob;
+	for (const FUtuPluginMaterial& UtuMaterial : json.materials)
+	{
+		if (UtuMaterial.asset_relative_filename.StartsWith("Resources") || MaterialRedirects.Contains(UtuMaterial.asset_relative_filename))
+		{
+			continue;
+		}
+		int MetallicIndex = UtuMaterial.material_textures_names.Find(ImportSettings.Materials.OrmMetallicSmoothnessTextureName);
+		int OcclusionIndex = UtuMaterial.material_textures_names.Find(ImportSettings.Materials.OrmOcclusionTextureName);
+		if (!UtuMaterial.material_textures.IsValidIndex(MetallicIndex) || !UtuMaterial.material_textures.IsValidIndex(OcclusionIndex) || UtuMaterial.material_textures[MetallicIndex] == "" || UtuMaterial.material_textures[OcclusionIndex] == "")
+		{
+			continue;
+		}
+		FString MetallicPath = UtuMaterial.material_textures[MetallicIndex];
+		FString OcclusionPath = UtuMaterial.material_textures[OcclusionIndex];
+		FString Pair = MetallicPath + "|" + OcclusionPath;
+		if (!PairToJob.Contains(Pair))
+		{
+			FUtuOrmPackJob Job;
+			Job.Metallic = GetTextureFromUnityRelativeFilename(MetallicPath);
+			Job.Occlusion = GetTextureFromUnityRelativeFilename(OcclusionPath);
+			Job.MetallicFilename = TextureFilenames.FindRef(MetallicPath);
+			Job.OcclusionFilename = TextureFilenames.FindRef(OcclusionPath);
+			Job.bValid = Job.Metallic != nullptr && Job.Occlusion != nullptr && Job.Metallic != GetFallbackTexture() && Job.Occlusion != GetFallbackTexture();
+			if (Job.bValid)
+			{
+				// Used when the source file isn't part of this export
+				Job.Hash = Job.Metallic->Source.GetId().ToString() + Job.Occlusion->Source.GetId().ToString();
+			}
+			PairToJob.Add(Pair, Jobs.Add(Job));
+		}
+		MaterialToJob.Add(UtuMaterial.asset_relative_filename, PairToJob[Pair]);
+	}
+
+	// Hash the sources on worker threads
+	ParallelFor(Jobs.Num(), [&Jobs](int32 Index)
+	{
+		FUtuOrmPackJob& Job = Jobs[Index];
+		if (Job.bValid && FPaths::FileExists(Job.MetallicFilename) && FPaths::FileExists(Job.OcclusionFilename))
+		{
+			Job.Hash = LexToString(FMD5Hash::HashFile(*Job.MetallicFilename)) + LexToString(FMD5Hash::HashFile(*Job.OcclusionFilename));
+		}
+	});
+
+	// Reuse the packed textures of previous imports
+	int CachedCount = 0;
+	for (FUtuOrmPackJob& Job : Jobs)
+	{
+		if (!Job.bValid)
+		{
+			continue;
+		}
+		Job.AssetPath = "/Game/Utu/Generated/ORM/T_ORM_" + FMD5::HashAnsiString(*Job.Hash);
+		if (UUtuPluginLibrary::TryGetAsset(Job.AssetPath) != nullptr)
+		{
+			CachedCount++;
+			continue;
+		}
+		Job.bNeedsPacking = true;
+		Job.bMetallicG8 = Job.Metallic->Source.GetFormat() == TSF_G8;
+		Job.bOcclusionG8 = Job.Occlusion->Source.GetFormat() == TSF_G8;
+		if ((!Job.bMetallicG8 && Job.Metallic->Source.GetFormat() != TSF_BGRA8) || (!Job.bOcclusionG8 && Job.Occlusion->Source.GetFormat() != TSF_BGRA8) ||
+			!Job.Metallic->Source.GetMipData(Job.MetallicData, 0) || !Job.Occlusion->Source.GetMipData(Job.OcclusionData, 0))
+		{
+			UTU_LOG_W("    Unsupported source format, textures kept separate: '" + Job.Metallic->GetPathName() + "' + '" + Job.Occlusion->GetPathName() + "'");
+			Job.bValid = false;
+			continue;
+		}
+		Job.MetallicSize[0] = Job.Metallic->Source.GetSizeX();
+		Job.MetallicSize[1] = Job.Metallic->Source.GetSizeY();
+		Job.OcclusionSize[0] = Job.Occlusion->Source.GetSizeX();
+		Job.OcclusionSize[1] = Job.Occlusion->Source.GetSizeY();
+		Job.Width = FMath::Max(Job.MetallicSize[0], Job.OcclusionSize[0]);
+		Job.Height = FMath::Max(Job.MetallicSize[1], Job.OcclusionSize[1]);
+		Job.Packed.SetNumUninitialized((int64)Job.Width * Job.Height * 4);
+	}
+
+	// Pack on worker threads. R = Occlusion, G = Roughness (1 - Smoothness), B = Metallic
+	for (FUtuOrmPackJob& Job : Jobs)
+	{
+		if (!Job.bValid || !Job.bNeedsPacking)
+		{
+			continue;
+		}
+		ParallelFor(Job.Height, [&Job](int32 Y)
+		{
+			for (int32 X = 0; X < Job.Width; X++)
+			{
+				// Nearest sampling when both sources aren't the same size. BGRA8 is stored as B, G, R, A
+				int64 MetallicTexel = (int64)(Y * Job.MetallicSize[1] / Job.Height) * Job.MetallicSize[0] + (X * Job.MetallicSize[0] / Job.Width);
+				int64 OcclusionTexel = (int64)(Y * Job.OcclusionSize[1] / Job.Height) * Job.OcclusionSize[0] + (X * Job.OcclusionSize[0] / Job.Width);
+				uint8 Metallic = Job.bMetallicG8 ? Job.MetallicData[MetallicTexel] : Job.MetallicData[MetallicTexel * 4 + 2];
+				// A source without alpha samples as 1 in Unity, the material's _GlossMapScale still applies on top of it
+				uint8 Smoothness = Job.bMetallicG8 ? 255 : Job.MetallicData[MetallicTexel * 4 + 3];
+				uint8 Occlusion = Job.bOcclusionG8 ? Job.OcclusionData[OcclusionTexel] : Job.OcclusionData[OcclusionTexel * 4 + 1];
+				int64 Out = ((int64)Y * Job.Width + X) * 4;
+				Job.Packed[Out + 0] = Metallic;
+				Job.Packed[Out + 1] = 255 - Smoothness;
+				Job.Packed[Out + 2] = Occlusion;
+				Job.Packed[Out + 3] = 255;
+			}
+		});
+	}
+
+	// Create the assets
+	int PackedCount = 0;
+	for (FUtuOrmPackJob& Job : Jobs)
+	{
+		if (!Job.bValid || !Job.bNeedsPacking)
+		{
+			continue;
+		}
+		FString Name = FPaths::GetBaseFilename(Job.AssetPath);
+		UPackage* Package = CreateAssetPackage(Job.AssetPath, false);
+		UTexture2D* Texture = NewObject<UTexture2D>(Package, FName(*Name), RF_Public | RF_Standalone);
+		Texture->Source.Init(Job.Width, Job.Height, 1, 1, TSF_BGRA8, Job.Packed.GetData());
+		Texture->SRGB = false;
+		Texture->CompressionSettings = TC_Masks;
+		Texture->PostEditChange();
+		LogAssetImportedOrFailed(Texture, { FPaths::GetPath(Job.AssetPath), Name, Job.AssetPath }, "", "Texture", { });
+		Job.Packed.Empty();
+		Job.MetallicData.Empty();
+		Job.OcclusionData.Empty();
+		PackedCount++;
+	}
+
+	for (const TPair<FString, int>& MaterialJob : MaterialToJob)
+	{
+		if (Jobs[MaterialJob.Value].bValid)
+		{
+			OrmTextures.Add(MaterialJob.Key, Jobs[MaterialJob.Value].AssetPath);
+		}
+	}
+	UTU_LOG_L("    ORM Textures: " + FString::FromInt(PackedCount) + " packed, " + FString::FromInt(CachedCount) + " reused, used by " + FString::FromInt(OrmTextures.Num()) + " materials.");
+	UTU_LOG_SEPARATOR_LINE();
+}
+
+void FUtuPluginAssetTypeProcessor::ApplyPackedOrmTexture(FUtuPluginMaterial InUtuMaterial, FUtuMaterialInstanceTarget& InOutTarget)
+{
+	const FString* OrmTexturePath = OrmTextures.Find(InUtuMaterial.asset_relative_filename);
+	UMaterial* ParentMaterial = Cast<UMaterial>(InOutTarget.Parent);
+	if (OrmTexturePath == nullptr || ParentMaterial == nullptr)
+	{
+		return;
+	}
+	UTexture* OrmTexture = Cast<UTexture>(UUtuPluginLibrary::TryGetAsset(*OrmTexturePath));
+	UMaterial* OrmParentMaterial = OrmTexture != nullptr ? GetOrCreateOrmParentMaterial(ParentMaterial, OrmTexture) : nullptr;
+	if (OrmParentMaterial != nullptr)
+	{
+		UTU_LOG_L("        Packed ORM Texture: " + *OrmTexturePath);
+		InOutTarget.Parent = OrmParentMaterial;
+		InOutTarget.Textures.Remove(*ImportSettings.Materials.OrmMetallicSmoothnessTextureName);
+		InOutTarget.Textures.Remove(*ImportSettings.Materials.OrmOcclusionTextureName);
+		InOutTarget.Textures.Add(FName("Utu_ORM"), OrmTexture);
+	}
+}
+
+UMaterial* FUtuPluginAssetTypeProcessor::GetOrCreateOrmParentMaterial(UMaterial* InParentMaterial, UTexture* InDefaultTexture)
+{
+	UTU_TRACE_SCOPE("UtuPlugin::GetOrCreateOrmParentMaterial");
+	if (UMaterial** Existing = OrmParentMaterials.Find(InParentMaterial))
+	{
+		return *Existing;
+	}
+	// Only the shipped Utu shaders get a variant, custom shaders are left to the user
+	UMaterial* Variant = nullptr;
+	if (InParentMaterial->GetPathName().StartsWith("/Game/Utu/Shaders/"))
+	{
+		FString VariantDir = "/Game/Utu/Shaders/ORM";
+		FString VariantName = InParentMaterial->GetName() + "_ORM";
+		Variant = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(VariantDir + "/" + VariantName));
+		if (Variant == nullptr && RewireOrmSamplers(InParentMaterial, InDefaultTexture, true))
+		{
+			UTU_LOG_L("        Creating ORM variant of parent material: '" + VariantDir + "/" + VariantName + "' ...");
+			Variant = Cast<UMaterial>(AssetTools->Get().DuplicateAsset(VariantName, VariantDir, InParentMaterial));
+			if (Variant != nullptr)
+			{
+				Variant->PreEditChange(NULL);
+				RewireOrmSamplers(Variant, InDefaultTexture, false);
+				Variant->MarkPackageDirty();
+				MaterialPostEditChange(Variant);
+			}
+		}
+	}
+	if (Variant == nullptr)
+	{
+		UTU_LOG_L("        Parent material '" + InParentMaterial->GetName() + "' can't read a packed ORM texture. Textures kept separate.");
+	}
+	OrmParentMaterials.Add(InParentMaterial, Variant);
+	return Variant;
+}
+
+bool FUtuPluginAssetTypeProcessor::RewireOrmSamplers(UMaterial* InMaterial, UTexture* InDefaultTexture, bool bCheckOnly)
+{
+	UMaterialExpressionTextureSampleParameter2D* MetallicSampler = Cast<UMaterialExpressionTextureSampleParameter2D>(FindIndexedExpression(InMaterial, UMaterialExpressionTextureSampleParameter2D::StaticClass(), ImportSettings.Materials.OrmMetallicSmoothnessTextureName));
+	UMaterialExpressionTextureSampleParameter2D* OcclusionSampler = Cast<UMaterialExpressionTextureSampleParameter2D>(FindIndexedExpression(InMaterial, UMaterialExpressionTextureSampleParameter2D::StaticClass(), ImportSettings.Materials.OrmOcclusionTextureName));
+	if (MetallicSampler == nullptr || OcclusionSampler == nullptr)
+	{
+		return false;
+	}
+
+	// Every input of the graph, material outputs included
+	TArray<FExpressionInput*> Inputs;
+#if ENGINE_MAJOR_VERSION >= 5
+	for (UMaterialExpression* Exp : InMaterial->GetExpressions())
+#else
+	for (UMaterialExpression* Exp : InMaterial->Expressions)
+#endif
+	{
+		if (Exp != nullptr)
+		{
+			Inputs.Append(Exp->GetInputs());
+		}
+	}
+	for (int Property = 0; Property < MP_MAX; Property++)
+	{
+		FExpressionInput* Input = InMaterial->GetExpressionInputForProperty((EMaterialProperty)Property);
+		if (Input != nullptr)
+		{
+			Inputs.AddUnique(Input);
+		}
+	}
+
+	// Only single channel reads can be remapped. Sampler outputs are RGB, R, G, B, A, RGBA
+	for (FExpressionInput* Input : Inputs)
+	{
+		if (Input->Expression == MetallicSampler && Input->OutputIndex != 1 && Input->OutputIndex != 4)
+		{
+			return false;
+		}
+		if (Input->Expression == OcclusionSampler && Input->OutputIndex != 1 && Input->OutputIndex != 2)
+		{
+			return false;
+		}
+	}
+	if (bCheckOnly)
+	{
+		return true;
+	}
+
+	UMaterialExpressionTextureSampleParameter2D* OrmSampler = GetOrCreateTextureParameter(InMaterial, InDefaultTexture, "Utu_ORM", MetallicSampler->MaterialExpressionEditorX, MetallicSampler->MaterialExpressionEditorY, FUtuPluginMaterial());
+	UMaterialExpressionOneMinus* Smoothness = Cast<UMaterialExpressionOneMinus>(UMaterialEditingLibrary::CreateMaterialExpression(InMaterial, UMaterialExpressionOneMinus::StaticClass(), MetallicSampler->MaterialExpressionEditorX + 300, MetallicSampler->MaterialExpressionEditorY));
+	if (OrmSampler == nullptr || Smoothness == nullptr)
+	{
+		return false;
+	}
+	OrmSampler->SamplerType = SAMPLERTYPE_Masks;
+	OrmSampler->Coordinates = MetallicSampler->Coordinates;
+	OrmSampler->ConnectExpression(&Smoothness->Input, 2);
+	for (FExpressionInput* Input : Inputs)
+	{
+		if (Input->Expression == MetallicSampler)
+		{
+			if (Input->OutputIndex == 1)
+			{
+				OrmSampler->ConnectExpression(Input, 3);
+			}
+			else
+			{
+				Smoothness->ConnectExpression(Input, 0);
+			}
+		}
+		else if (Input->Expression == OcclusionSampler)
+		{
+			OrmSampler->ConnectExpression(Input, 1);
+		}
+	}
+	UMaterialEditingLibrary::DeleteMaterialExpression(InMaterial, MetallicSampler);
+	UMaterialEditingLibrary::DeleteMaterialExpression(InMaterial, OcclusionSampler);
+	BuildExpressionIndex(InMaterial);
+	return true;
+}
+
+void FUtuPluginAssetTypeProcessor::ApplyVirtualTextures(FUtuMaterialInstanceTarget& InOutTarget)
+{
+	UMaterial* ParentMaterial = Cast<UMaterial>(InOutTarget.Parent);
+	if (ParentMaterial == nullptr)
+	{
+		return;
+	}
+	TArray<FString> Names;
+	TSet<FName> VirtualParameterNames;
+	for (const TPair<FName, UTexture*>& Texture : InOutTarget.Textures)
+	{
+		if (Texture.Value != nullptr && Texture.Value->VirtualTextureStreaming)
+		{
+			Names.Add(Texture.Key.ToString());
+			VirtualParameterNames.Add(Texture.Key);
+		}
+	}
+	if (VirtualParameterNames.Num() == 0)
+	{
+		return;
+	}
+
+	// One variant per parent and set of virtual parameters
+	Names.Sort();
+	FString VariantDir = FPaths::GetPath(ParentMaterial->GetPathName()) + "/VT";
+	FString VariantName = ParentMaterial->GetName() + "_VT_" + FString::Printf(TEXT("%08X"), FCrc::StrCrc32(*FString::Join(Names, TEXT("|"))));
+	if (!VirtualParentMaterials.Contains(VariantName))
+	{
+		UMaterial* Variant = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(VariantDir + "/" + VariantName));
+		if (Variant == nullptr && SetVirtualSamplers(ParentMaterial, VirtualParameterNames, true))
+		{
+			UTU_LOG_L("        Creating Virtual Texture variant of parent material: '" + VariantDir + "/" + VariantName + "' ...");
+			Variant = Cast<UMaterial>(AssetTools->Get().DuplicateAsset(VariantName, VariantDir, ParentMaterial));
+			if (Variant != nullptr)
+			{
+				Variant->PreEditChange(NULL);
+				SetVirtualSamplers(Variant, VirtualParameterNames, false);
+				Variant->MarkPackageDirty();
+				MaterialPostEditChange(Variant);
+			}
+		}
+		VirtualParentMaterials.Add(VariantName, Variant);
+	}
+	if (VirtualParentMaterials[VariantName] != nullptr)
+	{
+		UTU_LOG_L("        Virtual Textures: " + FString::Join(Names, TEXT(", ")));
+		InOutTarget.Parent = VirtualParentMaterials[VariantName];
+	}
+}
+
+bool FUtuPluginAssetTypeProcessor::SetVirtualSamplers(UMaterial* InMaterial, const TSet<FName>& InParameterNames, bool bCheckOnly)
+{
+	// Samplers of InParameterNames become virtual, the other virtual samplers whose texture isn't virtual anymore are switched back
+	bool bFound = false;
+	if (InMaterial == nullptr)
+	{
+		return false;
+	}
+#if ENGINE_MAJOR_VERSION >= 5
+	for (UMaterialExpression* Exp : InMaterial->GetExpressions())
+#else
+	for (UMaterialExpression* Exp : InMaterial->Expressions)
+#endif
+	{
+		UMaterialExpressionTextureSampleParameter2D* Sampler = Cast<UMaterialExpressionTextureSampleParameter2D>(Exp);
+		if (Sampler == nullptr)
+		{
+			continue;
+		}
+		if (!InParameterNames.Contains(Sampler->ParameterName))
+		{
+			if (Sampler->Texture != nullptr && Sampler->Texture->VirtualTextureStreaming && Sampler->Texture->GetPathName() != "/Game/Utu/Assets/Texture_VT.Texture_VT")
+			{
+				continue;
+			}
+			EMaterialSamplerType RegularType = Sampler->SamplerType;
+			switch (Sampler->SamplerType)
+			{
+			default:
+				break;
+			case SAMPLERTYPE_VirtualColor:
+				RegularType = SAMPLERTYPE_Color;
+				break;
+			case SAMPLERTYPE_VirtualGrayscale:
+				RegularType = SAMPLERTYPE_Grayscale;
+				break;
+			case SAMPLERTYPE_VirtualAlpha:
+				RegularType = SAMPLERTYPE_Alpha;
+				break;
+			case SAMPLERTYPE_VirtualNormal:
+				RegularType = SAMPLERTYPE_Normal;
+				break;
+			case SAMPLERTYPE_VirtualMasks:
+				RegularType = SAMPLERTYPE_Masks;
+				break;
+			case SAMPLERTYPE_VirtualLinearColor:
+				RegularType = SAMPLERTYPE_LinearColor;
+				break;
+			case SAMPLERTYPE_VirtualLinearGrayscale:
+				RegularType = SAMPLERTYPE_LinearGrayscale;
+				break;
+			}
+			if (RegularType != Sampler->SamplerType)
+			{
+				bFound = true;
+				if (!bCheckOnly)
+				{
+					Sampler->SamplerType = RegularType;
+					if (Sampler->Texture == nullptr || Sampler->Texture->VirtualTextureStreaming)
+					{
+						Sampler->Texture = GetFallbackTexture();
+					}
+				}
+			}
+			continue;
+		}
+		EMaterialSamplerType VirtualType = Sampler->SamplerType;
+		switch (Sampler->SamplerType)
+		{
+		default:
+			break;
+		case SAMPLERTYPE_Color:
+			VirtualType = SAMPLERTYPE_VirtualColor;
+			break;
+		case SAMPLERTYPE_Grayscale:
+			VirtualType = SAMPLERTYPE_VirtualGrayscale;
+			break;
+		case SAMPLERTYPE_Alpha:
+			VirtualType = SAMPLERTYPE_VirtualAlpha;
+			break;
+		case SAMPLERTYPE_Normal:
+			VirtualType = SAMPLERTYPE_VirtualNormal;
+			break;
+		case SAMPLERTYPE_Masks:
+			VirtualType = SAMPLERTYPE_VirtualMasks;
+			break;
+		case SAMPLERTYPE_LinearColor:
+			VirtualType = SAMPLERTYPE_VirtualLinearColor;
+			break;
+		case SAMPLERTYPE_LinearGrayscale:
+			VirtualType = SAMPLERTYPE_VirtualLinearGrayscale;
+			break;
+		}
+		if (VirtualType != Sampler->SamplerType)
+		{
+			bFound = true;
+			if (!bCheckOnly)
+			{
+				Sampler->SamplerType = VirtualType;
+			}
+		}
+		if (!bCheckOnly && (Sampler->Texture == nullptr || !Sampler->Texture->VirtualTextureStreaming))
+		{
+			Sampler->Texture = GetVirtualFallbackTexture();
+		}
+	}
+	return bFound;
+}
+
+UMaterial* FUtuPluginAssetTypeProcessor::GetOrCreateParentMaterial(FUtuPluginMaterial InUtuMaterial)
+{
+	UTU_TRACE_SCOPE("UtuPlugin::GetOrCreateParentMaterial");
+	FString MatName = InUtuMaterial.shader_name;
+	MatName = MatName.Replace(TEXT(" "), TEXT(""));
+	MatName = MatName.Replace(TEXT("."), TEXT("_"));
+	MatName = MatName.Replace(TEXT("/"), TEXT("_"));
+	MatName = MatName.Replace(TEXT("("), TEXT(""));
+	MatName = MatName.Replace(TEXT(")"), TEXT(""));
+
+	// Default material (Supported materials)
+	FString MatDir = "/Game/Utu/Shaders/";
+	FString MatPath = MatDir + MatName;
+	UMaterial* Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
+	if (Material != nullptr)
+	{
+		UTU_LOG_L("        Parent Material: \"" + MatPath + "\"");
+		return Material;
+	}
+
+	// Custom material (Unsupported materials)
+	MatDir = "/Game/Utu/CustomShaders/";
+	MatPath = MatDir + MatName;
+	Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
+	if (Material != nullptr)
+	{
+		UTU_LOG_L("        Parent Material: \"" + MatPath + "\"");
+		return Material;
+	}
+
+	// Create custom material
+	UTU_LOG_W("        No Supported Material Found. Creating Custom Material: \"" + MatPath + "\" ...");
+	if (ImportSettings.Materials.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
+	{
+		UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+		UUtuPluginLog::SetAssetEventOutcome("Skipped");
+		return nullptr;
+	}
+
+	UPackage* Package = CreateAssetPackage(MatPath, false);
+	NewObject<UMaterialFactoryNew>()->FactoryCreateNew(UMaterial::StaticClass(), Package, FName(*MatName), RF_Public | RF_Standalone, NULL, GWarn);
+	Material = Cast<UMaterial>(UUtuPluginLibrary::TryGetAsset(MatPath));
+	LogAssetImportedOrFailed(Material, { MatDir, MatName, MatPath }, "", "Material", { });
+
+	// Process Material
+	if (Material != nullptr)
+	{
+		UTU_LOG_L("        Building Material...");
+		Material->PreEditChange(NULL);
+		Material->GetOutermost()->FullyLoad();
+		Material->MarkPackageDirty();
+		BuildExpressionIndex(Material);
+
+		int H = -2000;
+		int V = 700;
+		// Settings
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.MetallicIntensityMultiplier, "Utu_MetallicIntensityMultiplier", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.SpecularIntensityMultiplier, "Utu_SpecularIntensityMultiplier", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.EmissiveIntensityMultiplier, "Utu_EmissiveIntensityMultiplier", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.NormalIntensityMultiplier, "Utu_NormalIntensityMultiplier", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.OcclusionIntensityMultiplier, "Utu_OcclusionIntensityMultiplier", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.TexturesPannerTime, "Utu_TexturesPannerTime", H, V, InUtuMaterial);
+		H += 300;
+		GetOrCreateScalarParameter(Material, ImportSettings.Materials.RoughnessMultiplier, "Utu_RoughnessMultiplier", H, V, InUtuMaterial);
+
+
+		H = -2000;
+		V = 1000;
+		// Floats
+		for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_floats_names.Num(), InUtuMaterial.material_floats.Num()); Idx++)
+		{
+			FString Name = InUtuMaterial.material_floats_names[Idx];
+			float Value = InUtuMaterial.material_floats[Idx];
+			UMaterialExpressionScalarParameter* Scalar = GetOrCreateScalarParameter(Material, Value, *Name, H, V, InUtuMaterial);
+			H += 300;
+		}
+
+		H = -2000;
+		V = 1300;
+		// Textures & Panners
+		for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
+		{
+			FString Name = InUtuMaterial.material_textures_names[Idx];
+			UTexture2D* Value = GetTextureFromUnityRelativeFilename(InUtuMaterial.material_textures[Idx]);
+			UMaterialExpressionTextureSampleParameter2D* Texture = GetOrCreateTextureParameter(Material, Value, *Name, H + 600, V, InUtuMaterial);
+
+			int TexCoordIndex = InUtuMaterial.material_vector2s_names.Find(Name + "_ST_TexCoord");
+			int PannerIndex = InUtuMaterial.material_vector2s_names.Find(Name + "_ST_Panner");
+			if (TexCoordIndex >= 0 && PannerIndex >= 0)
+			{
+				FString TexCoordName = InUtuMaterial.material_vector2s_names[TexCoordIndex];
+				FVector2D TexCoordValue = FVector2D(1.0f);
+				if (InUtuMaterial.material_vector2s.IsValidIndex(TexCoordIndex))
+				{
+					TexCoordValue = InUtuMaterial.material_vector2s[TexCoordIndex];
 				}
 				UMaterialExpressionTextureCoordinate* TexCoordNode = GetOrCreateTexCoordExpression(Material, FVector2D(1.0f, 1.0f), TexCoordName + "_Node", H, V, InUtuMaterial);
 				UMaterialExpressionVectorParameter* TexCoord = GetOrCreateVectorParameter(Material, FLinearColor(TexCoordValue.X, TexCoordValue.Y, 0.0f, 0.0f), *TexCoordName, H, V + 50, InUtuMaterial);
@@ -1632,11 +2538,109 @@ UMaterial* FUtuPluginAssetTypeProcessor::GetOrCreateParentMaterial(FUtuPluginMat
 		}
 	}
 
-	Material->PostEditChange();
-	FGlobalComponentReregisterContext RecreateComponents;
+	if (ImportSettings.Materials.bBatchShaderCompilation)
+	{
+		MaterialPostEditChange(Material); // Components are re-registered once the batch is flushed
+	}
+	else
+	{
+		UTU_EVENT_STAGE(EUtuEventStage::PostEdit, Material->PostEditChange());
+		FGlobalComponentReregisterContext RecreateComponents;
+	}
 	return Material;
 }
 
+void FUtuPluginAssetTypeProcessor::MaterialPostEditChange(UMaterialInterface* InMaterial)
+{
+	if (ImportSettings.Materials.bBatchShaderCompilation)
+	{
+		bool bAlreadyDeferred = false;
+		DeferredMaterialsSet.Add(InMaterial, &bAlreadyDeferred);
+		if (!bAlreadyDeferred)
+		{
+			DeferredMaterials.Add(InMaterial);
+		}
+	}
+	else
+	{
+		UTU_EVENT_STAGE(EUtuEventStage::PostEdit, InMaterial->PostEditChange());
+	}
+}
+
+void FUtuPluginAssetTypeProcessor::FlushDeferredMaterials()
+{
+	UTU_TRACE_SCOPE("UtuPlugin::FlushDeferredMaterials");
+	if (DeferredMaterials.Num() == 0)
+	{
+		return;
+	}
+	UTU_LOG_SEPARATOR_LINE();
+	UTU_LOG_L("Submitting shader compilation for " + FString::FromInt(DeferredMaterials.Num()) + " materials...");
+	// Each material still compiles on its own, the batch only compiles every material once after all its edits and re-registers the components once
+	TArray<TWeakObjectPtr<UMaterialInterface>> Materials = MoveTemp(DeferredMaterials);
+	DeferredMaterials.Empty();
+	DeferredMaterialsSet.Empty();
+	for (TWeakObjectPtr<UMaterialInterface> Material : Materials)
+	{
+		if (Material.IsValid())
+		{
+			Material->PostEditChange();
+		}
+	}
+	FGlobalComponentReregisterContext RecreateComponents;
+	if (!ImportSettings.Materials.bWaitForShaderCompilation || GShaderCompilingManager == nullptr)
+	{
+		UTU_LOG_L("Shader compilation submitted, it continues in the background.");
+		return;
+	}
+
+	// Wait for the shaders of these materials and report the progress
+	auto GetCompilingNum = [&Materials]()
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		int Count = 0;
+		for (TWeakObjectPtr<UMaterialInterface> Material : Materials)
+		{
+			UMaterial* ParentMaterial = Cast<UMaterial>(Material.Get());
+			UMaterialInstance* InstanceMaterial = Cast<UMaterialInstance>(Material.Get());
+			if ((ParentMaterial != nullptr && ParentMaterial->IsCompiling()) || (InstanceMaterial != nullptr && InstanceMaterial->IsCompiling()))
+			{
+				Count++;
+			}
+		}
+		return Count;
+#else
+		return GShaderCompilingManager->GetNumRemainingJobs(); // No compilation state per material before UE5
+#endif
+	};
+	int Total = GetCompilingNum();
+	int Reported = 0;
+	int LastLoggedPercent = -1;
+	FScopedSlowTask SlowTask(Total, NSLOCTEXT("FlushDeferredMaterials", "CompileShaders", "Compiling shaders of imported materials..."), true, *GWarn);
+	SlowTask.MakeDialog(true/*bShowCancelButton*/);
+	for (int Remaining = Total; Remaining > 0; Remaining = GetCompilingNum())
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			UTU_LOG_W("Shader compilation wait cancelled, it continues in the background.");
+			return;
+		}
+		GShaderCompilingManager->ProcessAsyncResults(true, false);
+		int Completed = FMath::Clamp(Total - Remaining, 0, Total);
+		SlowTask.EnterProgressFrame(Completed - Reported);
+		Reported = Completed;
+		int Percent = Total > 0 ? (Completed * 100) / Total : 100;
+		if (Percent / 10 != LastLoggedPercent / 10)
+		{
+			LastLoggedPercent = Percent;
+			UTU_LOG_L("    Shader compilation: " + FString::FromInt(Completed) + " / " + FString::FromInt(Total) + " (" + FString::FromInt(Percent) + "%)");
+		}
+		FPlatformProcess::Sleep(0.1f);
+	}
+	GShaderCompilingManager->ProcessAsyncResults(false, false);
+	UTU_LOG_L("Shader compilation complete.");
+}
+
 
 FLinearColor FUtuPluginAssetTypeProcessor::HexToColor(FString InHex) {
 	return FLinearColor(FColor::FromHex(InHex));
@@ -1645,34 +2649,69 @@ FLinearColor FUtuPluginAssetTypeProcessor::HexToColor(FString InHex) {
 
 UTexture2D* FUtuPluginAssetTypeProcessor::GetTextureFromUnityRelativeFilename(FString InUnityRelativeFilename) {
 	if (InUnityRelativeFilename != "") {
-		TArray<FString> TexNames = FormatRelativeFilenameForUnreal(InUnityRelativeFilename, EUtuUnrealAssetType::Texture);
-		UTU_LOG_L("            Texture: " + TexNames[2]);
-		UTexture2D* TextureAsset = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset(TexNames[2]));
-		if (TextureAsset == nullptr) {
-			UTU_LOG_W("                Failed to associate texture because it doesn't exists: '" + TexNames[2] + "'");
-			TextureAsset = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset("/Game/Utu/Assets/Texture"));
+		InUnityRelativeFilename = GetTextureRedirect(InUnityRelativeFilename);
+		FUtuPluginCachedTexture* Cached = ImportCache.IsValid() ? ImportCache->Textures.Find(InUnityRelativeFilename) : nullptr;
+		bool bCacheHit = Cached != nullptr && (!Cached->bExists || Cached->Texture.IsValid());
+		UtuPluginProfiling::RecordTextureCacheLookup(bCacheHit);
+		if (!bCacheHit) {
+			FUtuPluginCachedTexture NewCached;
+			NewCached.AssetRelativeFilename = FormatRelativeFilenameForUnreal(InUnityRelativeFilename, EUtuUnrealAssetType::Texture)[2];
+			NewCached.Texture = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset(NewCached.AssetRelativeFilename));
+			NewCached.bExists = NewCached.Texture.IsValid();
+			if (!ImportCache.IsValid()) {
+				ImportCache = MakeShared<FUtuPluginImportCache>();
+			}
+			Cached = &ImportCache->Textures.Add(InUnityRelativeFilename, NewCached);
 		}
-		return TextureAsset;
+		UTU_LOG_L("            Texture: " + Cached->AssetRelativeFilename);
+		if (!Cached->bExists) {
+			UTU_LOG_W("                Failed to associate texture because it doesn't exists: '" + Cached->AssetRelativeFilename + "'");
+			return GetFallbackTexture();
+		}
+		return Cached->Texture.Get();
 	}
 	return nullptr;
 }
 
+UTexture2D* FUtuPluginAssetTypeProcessor::GetFallbackTexture() {
+	if (!ImportCache.IsValid()) {
+		ImportCache = MakeShared<FUtuPluginImportCache>();
+	}
+	if (!ImportCache->FallbackTexture.IsValid()) {
+		ImportCache->FallbackTexture = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset("/Game/Utu/Assets/Texture"));
+	}
+	return ImportCache->FallbackTexture.Get();
+}
+
+UTexture2D* FUtuPluginAssetTypeProcessor::GetVirtualFallbackTexture() {
+	// Default texture of the virtual samplers, a virtual sampler doesn't compile with a regular texture
+	if (!ImportCache.IsValid()) {
+		ImportCache = MakeShared<FUtuPluginImportCache>();
+	}
+	if (!ImportCache->VirtualFallbackTexture.IsValid()) {
+		UTexture2D* Texture = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset("/Game/Utu/Assets/Texture_VT"));
+		if (Texture == nullptr && GetFallbackTexture() != nullptr) {
+			UTU_LOG_L("        Creating Virtual Texture fallback: '/Game/Utu/Assets/Texture_VT' ...");
+			Texture = Cast<UTexture2D>(AssetTools->Get().DuplicateAsset("Texture_VT", "/Game/Utu/Assets", GetFallbackTexture()));
+			if (Texture != nullptr) {
+				Texture->VirtualTextureStreaming = true;
+				Texture->PostEditChange();
+				Texture->MarkPackageDirty();
+			}
+		}
+		ImportCache->VirtualFallbackTexture = Texture;
+	}
+	return ImportCache->VirtualFallbackTexture.Get();
+}
+
 
 UMaterialExpressionTextureSampleParameter2D* FUtuPluginAssetTypeProcessor::GetOrCreateTextureParameter(UMaterial* InMaterial, UTexture* InTexture, FName InParamName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial) {
 	UMaterialExpressionTextureSampleParameter2D* Ret = nullptr;
 	UTU_LOG_L("                Texture Parameter: " + InParamName.ToString());
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionTextureSampleParameter2D* Parameter = Cast<UMaterialExpressionTextureSampleParameter2D>(Exp);
-			if (Parameter != nullptr && Parameter->ParameterName == InParamName) {
-				UTU_LOG_L("                    Texture Parameter found in material.");
-				Ret = Parameter;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionTextureSampleParameter2D>(FindIndexedExpression(InMaterial, UMaterialExpressionTextureSampleParameter2D::StaticClass(), InParamName.ToString()));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Texture Parameter found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1681,6 +2720,7 @@ UMaterialExpressionTextureSampleParameter2D* FUtuPluginAssetTypeProcessor::GetOr
 				UTU_LOG_L("                    Texture Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Texture Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1691,6 +2731,7 @@ UMaterialExpressionTextureSampleParameter2D* FUtuPluginAssetTypeProcessor::GetOr
 				UTU_LOG_L("                    Texture Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Texture Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1698,9 +2739,9 @@ UMaterialExpressionTextureSampleParameter2D* FUtuPluginAssetTypeProcessor::GetOr
 #endif
 		}
 		if (Ret != nullptr) {
-			if (InTexture == nullptr)
+			if (InTexture == nullptr || InTexture->VirtualTextureStreaming) // Virtual textures are only bound through the virtual variants
 			{
-				InTexture = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset("/Game/Utu/Assets/Texture"));
+				InTexture = GetFallbackTexture();
 			}
 			Ret->Texture = InTexture;
 			Ret->SamplerType = SAMPLERTYPE_Color;
@@ -1715,17 +2756,9 @@ UMaterialExpressionScalarParameter* FUtuPluginAssetTypeProcessor::GetOrCreateSca
 	UMaterialExpressionScalarParameter* Ret = nullptr;
 	UTU_LOG_L("                Scalar Parameter: " + InParamName.ToString());
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionScalarParameter* Parameter = Cast<UMaterialExpressionScalarParameter>(Exp);
-			if (Parameter != nullptr && Parameter->ParameterName == InParamName) {
-				UTU_LOG_L("                    Scalar Parameter found in material.");
-				Ret = Parameter;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionScalarParameter>(FindIndexedExpression(InMaterial, UMaterialExpressionScalarParameter::StaticClass(), InParamName.ToString()));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Scalar Parameter found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1734,6 +2767,7 @@ UMaterialExpressionScalarParameter* FUtuPluginAssetTypeProcessor::GetOrCreateSca
 				UTU_LOG_L("                    Scalar Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Scalar Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1744,6 +2778,7 @@ UMaterialExpressionScalarParameter* FUtuPluginAssetTypeProcessor::GetOrCreateSca
 				UTU_LOG_L("                    Scalar Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Scalar Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1763,17 +2798,9 @@ UMaterialExpressionVectorParameter* FUtuPluginAssetTypeProcessor::GetOrCreateVec
 	UMaterialExpressionVectorParameter* Ret = nullptr;
 	UTU_LOG_L("                Vector Parameter: " + InParamName.ToString());
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionVectorParameter* Parameter = Cast<UMaterialExpressionVectorParameter>(Exp);
-			if (Parameter != nullptr && Parameter->ParameterName == InParamName) {
-				UTU_LOG_L("                    Vector Parameter found in material.");
-				Ret = Parameter;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionVectorParameter>(FindIndexedExpression(InMaterial, UMaterialExpressionVectorParameter::StaticClass(), InParamName.ToString()));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Vector Parameter found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1782,6 +2809,7 @@ UMaterialExpressionVectorParameter* FUtuPluginAssetTypeProcessor::GetOrCreateVec
 				UTU_LOG_L("                    Vector Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Vector Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1792,6 +2820,7 @@ UMaterialExpressionVectorParameter* FUtuPluginAssetTypeProcessor::GetOrCreateVec
 				UTU_LOG_L("                    Vector Parameter added into material.");
 				Ret->ParameterName = InParamName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InParamName.ToString());
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Vector Parameter expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1811,17 +2840,9 @@ UMaterialExpressionComponentMask* FUtuPluginAssetTypeProcessor::GetOrCreateMaskE
 	UMaterialExpressionComponentMask* Ret = nullptr;
 	UTU_LOG_L("                Mask Expression: " + InExpressionName);
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionComponentMask* Expression = Cast<UMaterialExpressionComponentMask>(Exp);
-			if (Expression != nullptr && Expression->Desc == InExpressionName) {
-				UTU_LOG_L("                    Mask Expression found in material.");
-				Ret = Expression;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionComponentMask>(FindIndexedExpression(InMaterial, UMaterialExpressionComponentMask::StaticClass(), InExpressionName));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Mask Expression found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1830,6 +2851,7 @@ UMaterialExpressionComponentMask* FUtuPluginAssetTypeProcessor::GetOrCreateMaskE
 				UTU_LOG_L("                   Mask Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Mask Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1840,6 +2862,7 @@ UMaterialExpressionComponentMask* FUtuPluginAssetTypeProcessor::GetOrCreateMaskE
 				UTU_LOG_L("                   Mask Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Mask Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1862,17 +2885,9 @@ UMaterialExpressionMultiply* FUtuPluginAssetTypeProcessor::GetOrCreateMultiplyEx
 	UMaterialExpressionMultiply* Ret = nullptr;
 	UTU_LOG_L("                Multiply Expression: " + InExpressionName);
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionMultiply* Expression = Cast<UMaterialExpressionMultiply>(Exp);
-			if (Expression != nullptr && Expression->Desc == InExpressionName) {
-				UTU_LOG_L("                    Multiply Expression found in material.");
-				Ret = Expression;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionMultiply>(FindIndexedExpression(InMaterial, UMaterialExpressionMultiply::StaticClass(), InExpressionName));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Multiply Expression found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1881,6 +2896,7 @@ UMaterialExpressionMultiply* FUtuPluginAssetTypeProcessor::GetOrCreateMultiplyEx
 				UTU_LOG_L("                   Multiply Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to createMultiply Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1891,6 +2907,7 @@ UMaterialExpressionMultiply* FUtuPluginAssetTypeProcessor::GetOrCreateMultiplyEx
 				UTU_LOG_L("                   Multiply Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to createMultiply Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1909,17 +2926,9 @@ UMaterialExpressionPanner* FUtuPluginAssetTypeProcessor::GetOrCreatePannerExpres
 	UMaterialExpressionPanner* Ret = nullptr;
 	UTU_LOG_L("                Panner Expression: " + InExpressionName);
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionPanner* Expression = Cast<UMaterialExpressionPanner>(Exp);
-			if (Expression != nullptr && Expression->Desc == InExpressionName) {
-				UTU_LOG_L("                    Panner Expression found in material.");
-				Ret = Expression;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionPanner>(FindIndexedExpression(InMaterial, UMaterialExpressionPanner::StaticClass(), InExpressionName));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    Panner Expression found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1928,6 +2937,7 @@ UMaterialExpressionPanner* FUtuPluginAssetTypeProcessor::GetOrCreatePannerExpres
 				UTU_LOG_L("                   Panner Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Panner Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1938,6 +2948,7 @@ UMaterialExpressionPanner* FUtuPluginAssetTypeProcessor::GetOrCreatePannerExpres
 				UTU_LOG_L("                   Panner Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create Panner Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1958,17 +2969,9 @@ UMaterialExpressionTextureCoordinate* FUtuPluginAssetTypeProcessor::GetOrCreateT
 	UMaterialExpressionTextureCoordinate* Ret = nullptr;
 	UTU_LOG_L("                TexCoord Expression: " + InExpressionName);
 	if (InMaterial != nullptr) {
-#if ENGINE_MAJOR_VERSION >= 5
-		for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
-#else
-		for (UMaterialExpression* Exp : InMaterial->Expressions) {
-#endif
-			UMaterialExpressionTextureCoordinate* Expression = Cast<UMaterialExpressionTextureCoordinate>(Exp);
-			if (Expression != nullptr && Expression->Desc == InExpressionName) {
-				UTU_LOG_L("                    TexCoord Expression found in material.");
-				Ret = Expression;
-				break;
-			}
+		Ret = Cast<UMaterialExpressionTextureCoordinate>(FindIndexedExpression(InMaterial, UMaterialExpressionTextureCoordinate::StaticClass(), InExpressionName));
+		if (Ret != nullptr) {
+			UTU_LOG_L("                    TexCoord Expression found in material.");
 		}
 		if (Ret == nullptr) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -1977,6 +2980,7 @@ UMaterialExpressionTextureCoordinate* FUtuPluginAssetTypeProcessor::GetOrCreateT
 				UTU_LOG_L("                   TexCoord Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->AddExpressionParameter(Ret, InMaterial->EditorParameters);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create TexCoord Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -1987,6 +2991,7 @@ UMaterialExpressionTextureCoordinate* FUtuPluginAssetTypeProcessor::GetOrCreateT
 				UTU_LOG_L("                   TexCoord Expression added into material.");
 				Ret->Desc = InExpressionName;
 				InMaterial->Expressions.Add(Ret);
+				AddIndexedExpression(InMaterial, Ret, InExpressionName);
 			}
 			else {
 				UTU_LOG_E("                    Failed to create TexCoord Expression expression for Material: '" + InUtuMaterial.asset_relative_filename + "'. This is not normal and should never happen.");
@@ -2000,25 +3005,94 @@ UMaterialExpressionTextureCoordinate* FUtuPluginAssetTypeProcessor::GetOrCreateT
 			Ret->VTiling = InValue.Y;
 		}
 		}
-	return Ret;
+	return Ret;
+	}
+
+UMaterialExpression* FUtuPluginAssetTypeProcessor::FindIndexedExpression(UMaterial* InMaterial, UClass* InClass, FString InName)
+{
+	UtuPluginProfiling::RecordExpressionIndexLookup(ExpressionIndexMaterial == InMaterial);
+	if (ExpressionIndexMaterial != InMaterial)
+	{
+		BuildExpressionIndex(InMaterial);
+	}
+	UMaterialExpression** Expression = ExpressionIndex.Find(InClass->GetName() + "|" + InName);
+	return Expression != nullptr ? *Expression : nullptr;
+}
+
+void FUtuPluginAssetTypeProcessor::AddIndexedExpression(UMaterial* InMaterial, UMaterialExpression* InExpression, FString InName)
+{
+	if (ExpressionIndexMaterial != InMaterial)
+	{
+		BuildExpressionIndex(InMaterial);
+		return; // Already indexed by the rebuild
+	}
+	// Indexed under every class it can be cast to, first one wins like the graph order
+	for (UClass* Class = InExpression->GetClass(); Class != nullptr && Class != UMaterialExpression::StaticClass(); Class = Class->GetSuperClass())
+	{
+		FString Key = Class->GetName() + "|" + InName;
+		if (!ExpressionIndex.Contains(Key))
+		{
+			ExpressionIndex.Add(Key, InExpression);
+		}
+	}
+}
+
+void FUtuPluginAssetTypeProcessor::BuildExpressionIndex(UMaterial* InMaterial)
+{
+	UTU_TRACE_SCOPE("UtuPlugin::BuildExpressionIndex");
+	ExpressionIndex.Empty();
+	ExpressionIndexMaterial = InMaterial;
+	if (InMaterial == nullptr)
+	{
+		return;
+	}
+#if ENGINE_MAJOR_VERSION >= 5
+	for (UMaterialExpression* Exp : InMaterial->GetExpressions()) {
+#else
+	for (UMaterialExpression* Exp : InMaterial->Expressions) {
+#endif
+		if (Exp == nullptr)
+		{
+			continue;
+		}
+		FString Name = Exp->Desc;
+		if (UMaterialExpressionParameter* Parameter = Cast<UMaterialExpressionParameter>(Exp))
+		{
+			Name = Parameter->ParameterName.ToString();
+		}
+		else if (UMaterialExpressionTextureSampleParameter* TextureParameter = Cast<UMaterialExpressionTextureSampleParameter>(Exp))
+		{
+			Name = TextureParameter->ParameterName.ToString();
+		}
+		AddIndexedExpression(InMaterial, Exp, Name);
 	}
+}
 
 void FUtuPluginAssetTypeProcessor::ProcessTexture(FUtuPluginTexture InUtuTexture) {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessTexture");
 	// Format Paths
 	TArray<FString> AssetNames = StartProcessAsset(InUtuTexture, EUtuUnrealAssetType::Texture);
+	if (ImportCache->TextureRedirects.Contains(InUtuTexture.asset_relative_filename)) {
+		UTU_LOG_L("        Asset skipped because it is identical to: '" + ImportCache->TextureRedirects[InUtuTexture.asset_relative_filename] + "'");
+		UUtuPluginLog::SetAssetEventOutcome("Deduplicated");
+		return;
+	}
 	// Invalid Asset
 	if (DeleteInvalidAssetIfNeeded(AssetNames, UTexture2D::StaticClass())) {
 		// Existing Asset
 		UTexture2D* Asset = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset(AssetNames[2]));
+		bool bExistingAsset = Asset != nullptr;
 		LogAssetImportOrReimport(Asset);
 
 		if (ImportSettings.Textures.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else if (Asset != nullptr && ImportSettings.Textures.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else
 		{
@@ -2029,7 +3103,7 @@ void FUtuPluginAssetTypeProcessor::ProcessTexture(FUtuPluginTexture InUtuTexture
 			else
 			{
 				// Create Asset
-				AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuTexture.texture_file_absolute_filename, AssetNames, nullptr) });
+				UTU_EVENT_STAGE(EUtuEventStage::Import, AssetTools->Get().ImportAssetTasks({ BuildTask(InUtuTexture.texture_file_absolute_filename, AssetNames, nullptr) }));
 				Asset = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset(AssetNames[2]));
 				LogAssetImportedOrFailed(Asset, AssetNames, InUtuTexture.texture_file_absolute_filename, "Texture", { "Invalid Texture File : Make sure that the texture file is a supported format by trying to import it manually in Unreal." });
 			}
@@ -2037,6 +3111,10 @@ void FUtuPluginAssetTypeProcessor::ProcessTexture(FUtuPluginTexture InUtuTexture
 			if (Asset != nullptr) 
 			{
 				Asset->PreEditChange(NULL);
+				if (!FMath::IsPowerOfTwo(Asset->Source.GetSizeX()) || !FMath::IsPowerOfTwo(Asset->Source.GetSizeY()))
+				{
+					ProcessNonPowerOfTwoTexture(Asset, InUtuTexture.asset_relative_filename);
+				}
 				if (Asset->IsNormalMap())
 				{
 					Asset->bFlipGreenChannel = ImportSettings.Textures.bFlipNormalMapGreenChannel;
@@ -2049,31 +3127,58 @@ void FUtuPluginAssetTypeProcessor::ProcessTexture(FUtuPluginTexture InUtuTexture
 				Asset->Filter = ImportSettings.Textures.Filter;
 				Asset->LODGroup = ImportSettings.Textures.LODGroup;
 				Asset->SRGB = ImportSettings.Textures.SRGB;
-				Asset->MaxTextureSize = ImportSettings.Textures.MaxTextureSize;
+				if (!bExistingAsset || !ImportSettings.Textures.bTexelDensityAnalysis) // Otherwise, keep the size computed by the analysis
+				{
+					Asset->MaxTextureSize = ImportSettings.Textures.MaxTextureSize;
+				}
 				Asset->CompressionQuality = ImportSettings.Textures.CompressionQuality;
 				Asset->MipGenSettings = ImportSettings.Textures.MipGenSettings;
 				Asset->DeferCompression = false;
-				Asset->PostEditChange();
+				if (ImportSettings.Textures.bConvertLargeTexturesToVirtual)
+				{
+					static const auto CVarVirtualTextures = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.VirtualTextures"));
+					bool bIsLarge = FMath::Max(Asset->Source.GetSizeX(), Asset->Source.GetSizeY()) >= ImportSettings.Textures.VirtualTextureMinSize;
+					if (bIsLarge && CVarVirtualTextures != nullptr && CVarVirtualTextures->GetValueOnAnyThread() == 0)
+					{
+						UTU_LOG_W("        Texture not converted to Virtual Texture because Virtual Texture support is disabled in the project settings.");
+					}
+					else
+					{
+						Asset->VirtualTextureStreaming = bIsLarge;
+					}
+				}
+				UTU_EVENT_STAGE(EUtuEventStage::PostEdit, Asset->PostEditChange());
 			}
 		}
+
+		// Publish for the material phase
+		FUtuPluginCachedTexture Cached;
+		Cached.AssetRelativeFilename = AssetNames[2];
+		Cached.Texture = Asset;
+		Cached.bExists = Asset != nullptr;
+		ImportCache->Textures.Add(InUtuTexture.asset_relative_filename, Cached);
 	}
 }
 
 void FUtuPluginAssetTypeProcessor::LogAssetCreateOrNot(UObject * InAsset) {
 	if (InAsset == nullptr) {
 		UTU_LOG_L("    New Asset. Creating...");
+		UUtuPluginLog::SetAssetEventOutcome("Created");
 	}
 	else {
 		UTU_LOG_L("    Existing Asset.");
+		UUtuPluginLog::SetAssetEventOutcome("Updated");
 	}
 }
 
 void FUtuPluginAssetTypeProcessor::LogAssetImportOrReimport(UObject * InAsset) {
 	if (InAsset == nullptr) {
 		UTU_LOG_L("    New Asset. Importing...");
+		UUtuPluginLog::SetAssetEventOutcome("Imported");
 	}
 	else {
 		UTU_LOG_L("    Existing Asset. Re-Importing...");
+		UUtuPluginLog::SetAssetEventOutcome("Reimported");
 	}
 }
 
@@ -2102,6 +3207,8 @@ void FUtuPluginAssetTypeProcessor::LogAssetImportedOrFailed(UObject * InAsset, T
 
 
 void FUtuPluginAssetTypeProcessor::ProcessPrefabFirstPass(FUtuPluginPrefabFirstPass InUtuPrefabFirstPass) {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessPrefabFirstPass");
+	PrefabsHaveStaticChild.Add(InUtuPrefabFirstPass.asset_relative_filename, InUtuPrefabFirstPass.has_any_static_child); // Combined meshes aren't in the json
 	// Make sure it does not save the bp on compile
 	UBlueprintEditorSettings* Settings = GetMutableDefault<UBlueprintEditorSettings>();
 	ESaveOnCompile OriginalSaveOnCompile = Settings->SaveOnCompile;
@@ -2119,10 +3226,12 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabFirstPass(FUtuPluginPrefabFirstP
 		if (ImportSettings.Blueprints.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else if (Asset != nullptr && ImportSettings.Blueprints.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 		{
 			UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+			UUtuPluginLog::SetAssetEventOutcome("Skipped");
 		}
 		else
 		{
@@ -2162,8 +3271,8 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabFirstPass(FUtuPluginPrefabFirstP
 				}
 				Cast<USceneComponent>(ExistingNodes[0]->ComponentTemplate)->SetMobility(InUtuPrefabFirstPass.has_any_static_child ? EComponentMobility::Static : EComponentMobility::Movable);
 				FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Asset);
-				FKismetEditorUtilities::CompileBlueprint(Asset);
-				Asset->PostEditChange();
+				UTU_EVENT_STAGE(EUtuEventStage::PostEdit, FKismetEditorUtilities::CompileBlueprint(Asset));
+				UTU_EVENT_STAGE(EUtuEventStage::PostEdit, Asset->PostEditChange());
 			}
 		}
 	}
@@ -2174,6 +3283,7 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabFirstPass(FUtuPluginPrefabFirstP
 
 void FUtuPluginAssetTypeProcessor::ProcessPrefabSecondPass(FUtuPluginPrefabSecondPass InUtuPrefabSecondPass) 
 {
+	UTU_TRACE_SCOPE("UtuPlugin::ProcessPrefabSecondPass");
 	// Make sure it does not save the bp on compile
 	UBlueprintEditorSettings* Settings = GetMutableDefault<UBlueprintEditorSettings>();
 	ESaveOnCompile OriginalSaveOnCompile = Settings->SaveOnCompile;
@@ -2187,10 +3297,12 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabSecondPass(FUtuPluginPrefabSecon
 	if (ImportSettings.Blueprints.ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess)
 	{
 		UTU_LOG_L("        Asset skipped because processing behavior is set to 'DoNotProcess'");
+		UUtuPluginLog::SetAssetEventOutcome("Skipped");
 	}
 	else if (Asset != nullptr && ImportSettings.Blueprints.ProcessingBehavior == EUtuProcessingBehavior::SkipExisting)
 	{
 		UTU_LOG_L("        Asset skipped because processing behavior is set to 'SkipExisting' and asset exists.");
+		UUtuPluginLog::SetAssetEventOutcome("Skipped");
 	}
 	else
 	{
@@ -2217,6 +3329,12 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabSecondPass(FUtuPluginPrefabSecon
 			IdToNode.Add(RootId, RootNode);
 			// Add Real Components
 			TArray<FString> UniqueNames;
+			bool bPacked = ImportSettings.Blueprints.bPackStaticPrefabs && BpCanBePacked(InUtuPrefabSecondPass);
+			if (bPacked)
+			{
+				BpAddPackedInstancedComponents(Asset, InUtuPrefabSecondPass, RootNode);
+				InUtuPrefabSecondPass.prefab_components.Empty(); // Already packed
+			}
 			UTU_LOG_L("    Adding real components...");
 			for (FUtuPluginActor PrefabComponent : InUtuPrefabSecondPass.prefab_components) 
 			{
@@ -2308,9 +3426,9 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabSecondPass(FUtuPluginPrefabSecon
 			}
 			// Dirty
 			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Asset);
-			FKismetEditorUtilities::CompileBlueprint(Asset);
+			UTU_EVENT_STAGE(EUtuEventStage::PostEdit, FKismetEditorUtilities::CompileBlueprint(Asset));
 			Asset->MarkPackageDirty();
-			Asset->PostEditChange();
+			UTU_EVENT_STAGE(EUtuEventStage::PostEdit, Asset->PostEditChange());
 		}
 	}
 	// Restore Save On Compile
@@ -2319,6 +3437,99 @@ void FUtuPluginAssetTypeProcessor::ProcessPrefabSecondPass(FUtuPluginPrefabSecon
 	Settings->RemoveFromRoot();
 }
 
+bool FUtuPluginAssetTypeProcessor::BpCanBePacked(FUtuPluginPrefabSecondPass InUtuPrefabSecondPass)
+{
+	const bool* bHasAnyStaticChild = PrefabsHaveStaticChild.Find(InUtuPrefabSecondPass.asset_relative_filename);
+	if (bHasAnyStaticChild == nullptr || !*bHasAnyStaticChild)
+	{
+		return false;
+	}
+	bool bHasAnyMesh = false;
+	for (const FUtuPluginActor& PrefabComponent : InUtuPrefabSecondPass.prefab_components)
+	{
+		if (PrefabComponent.actor_is_movable)
+		{
+			return false;
+		}
+		for (EUtuActorType CompType : PrefabComponent.actor_types)
+		{
+			if (CompType == EUtuActorType::StaticMesh)
+			{
+				if (!PrefabComponent.actor_is_visible)
+				{
+					return false;
+				}
+				bHasAnyMesh = true;
+			}
+			else if (CompType != EUtuActorType::Empty)
+			{
+				// Lights, cameras, skeletal meshes and nested prefabs need real components
+				return false;
+			}
+		}
+	}
+	return bHasAnyMesh;
+}
+
+void FUtuPluginAssetTypeProcessor::BpAddPackedInstancedComponents(UBlueprint* InAsset, FUtuPluginPrefabSecondPass InUtuPrefabSecondPass, USCS_Node* InRootNode)
+{
+	UTU_LOG_L("    Packing static components into instanced components...");
+	TMap<int, const FUtuPluginActor*> IdToComponent;
+	for (const FUtuPluginActor& PrefabComponent : InUtuPrefabSecondPass.prefab_components)
+	{
+		IdToComponent.Add(PrefabComponent.actor_id, &PrefabComponent);
+	}
+	// Group by Mesh + Materials, with transforms relative to the Blueprint root
+	TMap<FString, TArray<const FUtuPluginActor*>> Groups;
+	TMap<FString, TArray<FTransform>> GroupsTransforms;
+	for (const FUtuPluginActor& PrefabComponent : InUtuPrefabSecondPass.prefab_components)
+	{
+		if (!PrefabComponent.actor_types.Contains(EUtuActorType::StaticMesh) || IsUtuGeneratedLod(PrefabComponent.actor_mesh.actor_mesh_relative_filename))
+		{
+			continue;
+		}
+		FTransform Transform = FTransform(UtuConst::ConvertRotation(PrefabComponent.actor_relative_rotation), UtuConst::ConvertLocation(PrefabComponent.actor_relative_location), UtuConst::ConvertScale(PrefabComponent.actor_relative_scale));
+		int ParentId = PrefabComponent.actor_parent_id;
+		for (int Depth = 0; IdToComponent.Contains(ParentId) && Depth < IdToComponent.Num(); Depth++)
+		{
+			const FUtuPluginActor* Parent = IdToComponent[ParentId];
+			Transform = Transform * FTransform(UtuConst::ConvertRotation(Parent->actor_relative_rotation), UtuConst::ConvertLocation(Parent->actor_relative_location), UtuConst::ConvertScale(Parent->actor_relative_scale));
+			ParentId = Parent->actor_parent_id;
+		}
+		FString Key = PrefabComponent.actor_mesh.actor_mesh_relative_filename + "|" + PrefabComponent.actor_mesh.actor_mesh_relative_filename_if_separated;
+		for (FString Material : PrefabComponent.actor_mesh.actor_mesh_materials_relative_filenames)
+		{
+			Key += "|" + GetMaterialRedirect(Material);
+		}
+		Groups.FindOrAdd(Key).Add(&PrefabComponent);
+		GroupsTransforms.FindOrAdd(Key).Add(Transform);
+	}
+	// One instanced component per group
+	TArray<FString> UniqueNames;
+	for (const TPair<FString, TArray<const FUtuPluginActor*>>& Group : Groups)
+	{
+		const FUtuPluginActor* FirstComponent = Group.Value[0];
+		FString UniqueName = BpMakeUniqueName(FirstComponent->actor_display_name + "_Instances", UniqueNames);
+		UTU_LOG_L("        Adding InstancedStaticMesh component...");
+		UTU_LOG_L("            Component Name: '" + UniqueName + "'");
+		UTU_LOG_L("            Instances: " + FString::FromInt(Group.Value.Num()));
+		UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(InAsset, *UniqueName);
+		Component->SetMobility(EComponentMobility::Static);
+		Component->SetStaticMesh(WorldGetStaticMeshAsset(*FirstComponent));
+		AssignMaterialsToMesh(FirstComponent->actor_mesh.actor_mesh_materials_relative_filenames, Component);
+		// Instance index N is mapped to the Unity component stored in ComponentTags[N + 1] as "<Id>|<Tag>|<Name>"
+		Component->ComponentTags.Add("UtuInstances");
+		for (int x = 0; x < Group.Value.Num(); x++)
+		{
+			Component->AddInstance(GroupsTransforms[Group.Key][x]);
+			Component->ComponentTags.Add(MakeInstanceTag(*Group.Value[x]));
+		}
+		USCS_Node* ComponentNode = InAsset->SimpleConstructionScript->CreateNode(Component->GetClass(), *UniqueName);
+		UEditorEngine::CopyPropertiesForUnrelatedObjects(Component, ComponentNode->ComponentTemplate);
+		InRootNode->AddChildNode(ComponentNode);
+	}
+}
+
 void FUtuPluginAssetTypeProcessor::BpAddRootComponent(UBlueprint * InAsset, bool bStatic) 
 {
 	int RootNodeId = UtuConst::INVALID_INT;
@@ -2355,25 +3566,22 @@ AActor* FUtuPluginAssetTypeProcessor::WorldAddRootActorForSubActorsIfNeeded(UWor
 		UTU_LOG_L("                    Actor Class: 'AActor'");
 		UTU_LOG_L("                    Actor Tag: '" + InUtuActor.actor_tag + "'");
 		// Create Empty Root Actor
-		FActorSpawnParameters Params = FActorSpawnParameters();
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		RetActor = InAsset->SpawnActor<AActor>(Params);
+		RetActor = WorldSpawnActor(InAsset, AActor::StaticClass());
 		if (RetActor != nullptr) {
 			USceneComponent* RootComponent = NewObject<USceneComponent>(RetActor, USceneComponent::GetDefaultSceneRootVariableName(), RF_Transactional);
 			if (RootComponent != nullptr) {
 				RetActor->SetRootComponent(RootComponent);
 				RetActor->AddInstanceComponent(RootComponent);
-				RootComponent->RegisterComponent();
+				WorldRegisterComponent(RootComponent);
 				RetActor->SetActorLabel(InUtuActor.actor_display_name);
 				RetActor->Tags.Add(*FString::FromInt(InUtuActor.actor_id));
+				RetActor->Tags.Add(*("UtuId_" + FString::FromInt(InUtuActor.actor_id)));
 				if (InUtuActor.actor_tag != "Untagged") {
 					RetActor->Tags.Add(*InUtuActor.actor_tag);
 				}
 				RetActor->SetActorHiddenInGame(!InUtuActor.actor_is_visible);
 				RetActor->GetRootComponent()->SetVisibility(InUtuActor.actor_is_visible, true);
-				RetActor->SetActorLocation(UtuConst::ConvertLocation(InUtuActor.actor_world_location));
-				RetActor->SetActorRotation(UtuConst::ConvertRotation(InUtuActor.actor_world_rotation));
-				RetActor->SetActorScale3D(UtuConst::ConvertScale(InUtuActor.actor_world_scale));
+				RetActor->SetActorTransform(FTransform(UtuConst::ConvertRotation(InUtuActor.actor_world_rotation), UtuConst::ConvertLocation(InUtuActor.actor_world_location), UtuConst::ConvertScale(InUtuActor.actor_world_scale)));
 				RetActor->GetRootComponent()->SetMobility(InUtuActor.actor_is_movable ? EComponentMobility::Movable : EComponentMobility::Static);
 			}
 			else {
@@ -2385,69 +3593,540 @@ AActor* FUtuPluginAssetTypeProcessor::WorldAddRootActorForSubActorsIfNeeded(UWor
 				return nullptr; // Don't even bother returning the actor
 			}
 		}
-		else {
-			UTU_LOG_E("            Failed to spawn Root Actor...");
-			UTU_LOG_E("                Actor Name: '" + InUtuActor.actor_display_name + "'");
-			UTU_LOG_E("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
-			UTU_LOG_E("                Potential Causes:");
-			UTU_LOG_E("                    - No Potential Causes known yet, but it should never happen.");
-		}
+		else {
+			UTU_LOG_E("            Failed to spawn Root Actor...");
+			UTU_LOG_E("                Actor Name: '" + InUtuActor.actor_display_name + "'");
+			UTU_LOG_E("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
+			UTU_LOG_E("                Potential Causes:");
+			UTU_LOG_E("                    - No Potential Causes known yet, but it should never happen.");
+		}
+	}
+	return RetActor;
+}
+
+AActor* FUtuPluginAssetTypeProcessor::WorldSpawnStaticMeshActor(UWorld * InAsset, FUtuPluginActor InUtuActor) {
+	UTU_LOG_L("            Adding Static Mesh Actor...");
+	UTU_LOG_L("                Actor Name: '" + InUtuActor.actor_display_name + "'");
+	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
+	UTU_LOG_L("                Actor Class: 'AStaticMeshActor'");
+	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
+
+	// Check if not LOD
+	if (IsUtuGeneratedLod(InUtuActor.actor_mesh.actor_mesh_relative_filename))
+	{
+		UTU_LOG_L("                Actor skipped because it's a LOD and not a real mesh. LODs should already be included in LOD0 of this mesh.");
+		return nullptr;
+	}
+
+	AStaticMeshActor* RetActor = Cast<AStaticMeshActor>(WorldSpawnActor(InAsset, AStaticMeshActor::StaticClass()));
+	if (RetActor != nullptr) {
+		UTU_LOG_L("            Associating Static Mesh to Static Mesh Actor...");
+		UStaticMesh* StaticMeshAsset = WorldGetStaticMeshAsset(InUtuActor);
+		RetActor->GetStaticMeshComponent()->SetStaticMesh(StaticMeshAsset);
+		AssignMaterialsToMesh(InUtuActor.actor_mesh.actor_mesh_materials_relative_filenames, RetActor->GetStaticMeshComponent());
+		RetActor->SetActorLabel(InUtuActor.actor_display_name);
+	}
+	else {
+		UTU_LOG_E("            Failed to spawn StaticMesh Actor...");
+		UTU_LOG_E("                Actor Name: '" + InUtuActor.actor_display_name + "'");
+		UTU_LOG_E("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
+		UTU_LOG_E("                Potential Causes:");
+		UTU_LOG_E("                    - No Potential Causes known yet, but it should never happen.");
+	}
+	return RetActor;
+}
+
+AActor* FUtuPluginAssetTypeProcessor::WorldSpawnActor(UWorld* InAsset, UClass* InClass)
+{
+	FActorSpawnParameters Params = FActorSpawnParameters();
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	// Blueprints need their construction script to run right away so their components can be edited
+	bool bDeferConstruction = bIsBatchSpawning && Cast<UBlueprintGeneratedClass>(InClass) == nullptr;
+	Params.bDeferConstruction = bDeferConstruction;
+	AActor* RetActor = InAsset->SpawnActor<AActor>(InClass, Params);
+	if (RetActor != nullptr && bIsBatchSpawning)
+	{
+		// Actors with a native root still register it while spawning, only what the import adds afterwards waits
+		BatchSpawnedActors.Add(RetActor);
+		if (bDeferConstruction)
+		{
+			DeferredSpawnedActors.Add(RetActor);
+		}
+	}
+	return RetActor;
+}
+
+void FUtuPluginAssetTypeProcessor::WorldRegisterComponent(UActorComponent* InComponent)
+{
+	// In batch mode, the spawned actors register their components at the end
+	if (!bIsBatchSpawning)
+	{
+		InComponent->RegisterComponent();
+	}
+}
+
+UStaticMesh* FUtuPluginAssetTypeProcessor::WorldGetStaticMeshAsset(FUtuPluginActor InUtuActor)
+{
+	TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InUtuActor.actor_mesh.actor_mesh_relative_filename, EUtuUnrealAssetType::StaticMesh);
+	TArray<FString> MeshNamesSeparated = FormatRelativeFilenameForUnrealSeparated(InUtuActor.actor_mesh.actor_mesh_relative_filename, InUtuActor.actor_mesh.actor_mesh_relative_filename_if_separated, EUtuUnrealAssetType::StaticMesh);
+	UTU_LOG_L("                Unreal Asset Relative Path: " + MeshNames[2]);
+	UTU_LOG_L("                Unreal Asset Relative Path If Separated: " + MeshNamesSeparated[2]);
+	UStaticMesh* StaticMeshAsset = GetMeshAsset(ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames);
+	if (StaticMeshAsset == nullptr) {
+		StaticMeshAsset = GetMeshAsset(!ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames);
+	}
+	if (StaticMeshAsset == nullptr) {
+		UTU_LOG_W("                Failed to assign Static Mesh because it doesn't exists: '" + (ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames)[2] + "'");
+	}
+	return StaticMeshAsset;
+}
+
+bool FUtuPluginAssetTypeProcessor::IsUtuGeneratedLod(FString InMeshRelativeFilename)
+{
+	if (ImportSettings.StaticMeshes.bUtuGenerateLODs)
+	{
+		TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InMeshRelativeFilename, EUtuUnrealAssetType::StaticMesh);
+		if (MeshNames[1].Contains("_LOD"))
+		{
+			FString LodIndex = "";
+			MeshNames[1].Split("_LOD", nullptr, &LodIndex, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+			return LodIndex.IsNumeric() && LodIndex != "0"; // Keep main LOD
+		}
+	}
+	return false;
+}
+
+bool FUtuPluginAssetTypeProcessor::WorldCanBeInstanced(FUtuPluginActor InUtuActor, const TSet<int>& InParentIds)
+{
+	// Only plain, static, visible leaves can be collapsed without changing the look or the hierarchy of the scene
+	return InUtuActor.actor_types.Num() == 1
+		&& InUtuActor.actor_types[0] == EUtuActorType::StaticMesh
+		&& !InUtuActor.actor_is_movable
+		&& InUtuActor.actor_is_visible
+		&& !InParentIds.Contains(InUtuActor.actor_id)
+		&& !IsUtuGeneratedLod(InUtuActor.actor_mesh.actor_mesh_relative_filename);
+}
+
+TSet<int> FUtuPluginAssetTypeProcessor::WorldSpawnInstancedStaticMeshActors(UWorld* InAsset, TArray<FUtuPluginActor> InUtuActors, TMap<int, AActor*>& OutIdToActor, TMap<AActor*, int>& OutActorToParentId, TMap<FString, AActor*>& InOutOldGroups)
+{
+	TSet<int> InstancedIds;
+	TSet<int> ParentIds;
+	for (const FUtuPluginActor& UtuActor : InUtuActors)
+	{
+		ParentIds.Add(UtuActor.actor_parent_id);
+	}
+	// Group by Mesh + Materials + Parent, the group is attached to the parent of its instances
+	TMap<FString, TArray<FUtuPluginActor>> Groups;
+	for (const FUtuPluginActor& UtuActor : InUtuActors)
+	{
+		if (WorldCanBeInstanced(UtuActor, ParentIds))
+		{
+			FString Key = UtuActor.actor_mesh.actor_mesh_relative_filename + "|" + UtuActor.actor_mesh.actor_mesh_relative_filename_if_separated;
+			for (FString Material : UtuActor.actor_mesh.actor_mesh_materials_relative_filenames)
+			{
+				Key += "|" + GetMaterialRedirect(Material);
+			}
+			Key += "|Parent_" + FString::FromInt(UtuActor.actor_parent_id);
+#if ENGINE_MAJOR_VERSION >= 5
+			// One group per streaming cell and per data layer, so World Partition can still stream the instances
+			if (ImportSettings.Scenes.bCreateWorldPartition)
+			{
+				FVector Location = UtuConst::ConvertLocation(UtuActor.actor_world_location);
+				int CellSize = FMath::Max(ImportSettings.Scenes.WorldPartitionCellSize, 1);
+				Key += "|Cell_" + FString::FromInt(FMath::FloorToInt(Location.X / CellSize)) + "_" + FString::FromInt(FMath::FloorToInt(Location.Y / CellSize));
+				if (ImportSettings.Scenes.bCreateDataLayersFromTags)
+				{
+					Key += "|Tag_" + UtuActor.actor_tag;
+				}
+			}
+#endif
+			Groups.FindOrAdd(Key).Add(UtuActor);
+		}
+	}
+	UTU_LOG_L("        Instancing static mesh actors...");
+	for (const TPair<FString, TArray<FUtuPluginActor>>& Group : Groups)
+	{
+		if (Group.Value.Num() < FMath::Max(ImportSettings.Scenes.MinInstancesPerGroup, 1))
+		{
+			continue;
+		}
+		const FUtuPluginActor& FirstUtuActor = Group.Value[0];
+		FString GroupSignature = FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*Group.Key));
+		// Update the group from the previous import if it holds the same actors
+		AActor** OldGroupActor = InOutOldGroups.Find(GroupSignature);
+		if (OldGroupActor != nullptr)
+		{
+			UInstancedStaticMeshComponent* OldInstancesComponent = (*OldGroupActor)->FindComponentByClass<UInstancedStaticMeshComponent>();
+			TArray<int> OldIds = GetInstancesActorIds(OldInstancesComponent);
+			TArray<int> NewIds;
+			for (const FUtuPluginActor& UtuActor : Group.Value)
+			{
+				NewIds.Add(UtuActor.actor_id);
+			}
+			if (OldIds == NewIds && OldInstancesComponent->GetInstanceCount() == NewIds.Num())
+			{
+				// Re-attached once its parent is updated, so moving the parent doesn't move the instances placed below
+				if ((*OldGroupActor)->GetAttachParentActor() != nullptr)
+				{
+					(*OldGroupActor)->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+				}
+				int UpdatedInstancesCount = 0;
+				for (int x = 0; x < Group.Value.Num(); x++)
+				{
+					const FUtuPluginActor& UtuActor = Group.Value[x];
+					OldInstancesComponent->ComponentTags[x + 1] = MakeInstanceTag(UtuActor);
+					FTransform NewTransform = FTransform(UtuConst::ConvertRotation(UtuActor.actor_world_rotation), UtuConst::ConvertLocation(UtuActor.actor_world_location), UtuConst::ConvertScale(UtuActor.actor_world_scale));
+					FTransform OldTransform;
+					OldInstancesComponent->GetInstanceTransform(x, OldTransform, true);
+					if (!OldTransform.Equals(NewTransform))
+					{
+						OldInstancesComponent->UpdateInstanceTransform(x, NewTransform, true, false, true);
+						UpdatedInstancesCount++;
+					}
+					InstancedIds.Add(UtuActor.actor_id);
+					OutIdToActor.Add(UtuActor.actor_id, *OldGroupActor);
+				}
+				OutActorToParentId.Add(*OldGroupActor, FirstUtuActor.actor_parent_id);
+				if (UpdatedInstancesCount > 0)
+				{
+					OldInstancesComponent->MarkRenderStateDirty();
+				}
+				UTU_LOG_L("            Kept Instanced Static Mesh Actor: '" + (*OldGroupActor)->GetActorLabel() + "' (" + FString::FromInt(UpdatedInstancesCount) + " instances moved)");
+				InOutOldGroups.Remove(GroupSignature);
+				continue;
+			}
+		}
+		UTU_LOG_L("            Adding Instanced Static Mesh Actor...");
+		UTU_LOG_L("                Instances: " + FString::FromInt(Group.Value.Num()));
+		UStaticMesh* StaticMeshAsset = WorldGetStaticMeshAsset(FirstUtuActor);
+		if (StaticMeshAsset == nullptr)
+		{
+			continue;
+		}
+		AActor* GroupActor = WorldSpawnActor(InAsset, AActor::StaticClass());
+		if (GroupActor == nullptr)
+		{
+			UTU_LOG_E("            Failed to spawn Instanced Static Mesh Actor...");
+			UTU_LOG_E("                Static Mesh: '" + StaticMeshAsset->GetPathName() + "'");
+			UTU_LOG_E("                Potential Causes:");
+			UTU_LOG_E("                    - No Potential Causes known yet, but it should never happen.");
+			continue;
+		}
+		USceneComponent* RootComponent = NewObject<USceneComponent>(GroupActor, USceneComponent::GetDefaultSceneRootVariableName(), RF_Transactional);
+		RootComponent->SetMobility(EComponentMobility::Static);
+		GroupActor->SetRootComponent(RootComponent);
+		GroupActor->AddInstanceComponent(RootComponent);
+		WorldRegisterComponent(RootComponent);
+		UInstancedStaticMeshComponent* InstancesComponent = nullptr;
+		if (ImportSettings.Scenes.bUseHierarchicalInstances)
+		{
+			InstancesComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(GroupActor, FName("Instances"), RF_Transactional);
+		}
+		else
+		{
+			InstancesComponent = NewObject<UInstancedStaticMeshComponent>(GroupActor, FName("Instances"), RF_Transactional);
+		}
+		InstancesComponent->SetMobility(EComponentMobility::Static);
+		InstancesComponent->SetupAttachment(RootComponent);
+		GroupActor->AddInstanceComponent(InstancesComponent);
+		InstancesComponent->SetStaticMesh(StaticMeshAsset);
+		AssignMaterialsToMesh(FirstUtuActor.actor_mesh.actor_mesh_materials_relative_filenames, InstancesComponent);
+		// Instance index N is mapped to the Unity actor stored in ComponentTags[N + 1] as "<Id>|<Tag>|<Name>"
+		InstancesComponent->ComponentTags.Add("UtuInstances");
+		TArray<FTransform> InstancesTransforms;
+		for (const FUtuPluginActor& UtuActor : Group.Value)
+		{
+			InstancesTransforms.Add(FTransform(UtuConst::ConvertRotation(UtuActor.actor_world_rotation), UtuConst::ConvertLocation(UtuActor.actor_world_location), UtuConst::ConvertScale(UtuActor.actor_world_scale)));
+			InstancesComponent->ComponentTags.Add(MakeInstanceTag(UtuActor));
+			InstancedIds.Add(UtuActor.actor_id);
+			OutIdToActor.Add(UtuActor.actor_id, GroupActor);
+		}
+#if ENGINE_MAJOR_VERSION >= 5
+		InstancesComponent->AddInstances(InstancesTransforms, false);
+#else
+		for (const FTransform& InstanceTransform : InstancesTransforms)
+		{
+			InstancesComponent->AddInstance(InstanceTransform);
+		}
+#endif
+		WorldRegisterComponent(InstancesComponent);
+		GroupActor->SetActorLabel("Utu_Instances_" + StaticMeshAsset->GetName());
+		GroupActor->Tags.Add("UtuActor");
+		GroupActor->Tags.Add("UtuInstances");
+		GroupActor->Tags.Add(*("UtuGroup_" + GroupSignature));
+		OutActorToParentId.Add(GroupActor, FirstUtuActor.actor_parent_id);
+		UTU_LOG_L("                Actor Name: '" + GroupActor->GetActorLabel() + "'");
+	}
+	UTU_LOG_L("            " + FString::FromInt(InstancedIds.Num()) + " static mesh actors collapsed into instances.");
+	return InstancedIds;
+}
+
+void FUtuPluginAssetTypeProcessor::WorldUpdateExistingActor(AActor* InActor, FUtuPluginActor InUtuActor)
+{
+	UTU_LOG_L("        Updating '" + InUtuActor.actor_display_name + "'...");
+	if (InActor->GetActorLabel() != InUtuActor.actor_display_name)
+	{
+		InActor->SetActorLabel(InUtuActor.actor_display_name);
+	}
+	FTransform NewTransform = FTransform(UtuConst::ConvertRotation(InUtuActor.actor_world_rotation), UtuConst::ConvertLocation(InUtuActor.actor_world_location), UtuConst::ConvertScale(InUtuActor.actor_world_scale));
+	if (!InActor->GetActorTransform().Equals(NewTransform))
+	{
+		UTU_LOG_L("            Transform changed.");
+		InActor->SetActorTransform(NewTransform);
+	}
+	if (InActor->IsHidden() == InUtuActor.actor_is_visible)
+	{
+		UTU_LOG_L("            Visibility changed.");
+		InActor->SetActorHiddenInGame(!InUtuActor.actor_is_visible);
+		InActor->GetRootComponent()->SetVisibility(InUtuActor.actor_is_visible, true);
+	}
+	// Mesh and materials are not part of the signature of plain static mesh actors
+	AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(InActor);
+	FString MeshSignature = WorldGetActorMeshSignature(InUtuActor);
+	if (MeshActor != nullptr && GetActorTagValue(InActor, "UtuMeshSig_") != MeshSignature)
+	{
+		UTU_LOG_L("            Mesh or materials changed.");
+		MeshActor->GetStaticMeshComponent()->SetStaticMesh(WorldGetStaticMeshAsset(InUtuActor));
+		MeshActor->GetStaticMeshComponent()->EmptyOverrideMaterials();
+		AssignMaterialsToMesh(InUtuActor.actor_mesh.actor_mesh_materials_relative_filenames, MeshActor->GetStaticMeshComponent());
+		SetActorTagValue(InActor, "UtuMeshSig_", MeshSignature);
+	}
+}
+
+void FUtuPluginAssetTypeProcessor::WorldSetupWorldPartition(UWorld* InAsset, TArray<FUtuPluginActor> InUtuActors, const TMap<int, AActor*>& InIdToActor)
+{
+#if ENGINE_MAJOR_VERSION >= 5
+	UTU_LOG_L("        Setting up World Partition...");
+	UWorldPartition* WorldPartition = InAsset->GetWorldPartition();
+	if (WorldPartition == nullptr)
+	{
+		UTU_LOG_W("            Cannot setup World Partition because the existing level is not a World Partition level.");
+		UTU_LOG_W("                Potential Causes:");
+		UTU_LOG_W("                    - The level was created by a previous import without 'bCreateWorldPartition'. Delete it and import again.");
+		return;
+	}
+	// Runtime grids -- The spatial hash has no public setter for its grids, go through reflection and report what the engine version doesn't have
+	UObject* RuntimeHash = nullptr;
+	FObjectProperty* RuntimeHashProperty = FindFProperty<FObjectProperty>(WorldPartition->GetClass(), "RuntimeHash");
+	if (RuntimeHashProperty != nullptr)
+	{
+		RuntimeHash = RuntimeHashProperty->GetObjectPropertyValue_InContainer(WorldPartition);
+	}
+	FArrayProperty* GridsProperty = RuntimeHash != nullptr ? FindFProperty<FArrayProperty>(RuntimeHash->GetClass(), "Grids") : nullptr;
+	FStructProperty* GridProperty = GridsProperty != nullptr ? CastField<FStructProperty>(GridsProperty->Inner) : nullptr;
+	FIntProperty* CellSizeProperty = GridProperty != nullptr ? FindFProperty<FIntProperty>(GridProperty->Struct, "CellSize") : nullptr;
+	FFloatProperty* LoadingRangeProperty = GridProperty != nullptr ? FindFProperty<FFloatProperty>(GridProperty->Struct, "LoadingRange") : nullptr;
+	if (GridProperty == nullptr)
+	{
+		UTU_LOG_W("            Failed to find the runtime grids of the World Partition. Default cell size and loading range will be used.");
+		UTU_LOG_W("                Missing Property: '" + FString(RuntimeHashProperty == nullptr ? "WorldPartition.RuntimeHash" : RuntimeHash == nullptr ? "WorldPartition.RuntimeHash (None)" : "RuntimeHash.Grids") + "'");
+		UTU_LOG_W("                Potential Causes:");
+		UTU_LOG_W("                    - The World Partition of this engine version doesn't use a spatial hash or renamed its members.");
+	}
+	else
+	{
+		FScriptArrayHelper GridsHelper(GridsProperty, GridsProperty->ContainerPtrToValuePtr<void>(RuntimeHash));
+		for (int x = 0; x < GridsHelper.Num(); x++)
+		{
+			if (CellSizeProperty != nullptr)
+			{
+				CellSizeProperty->SetPropertyValue_InContainer(GridsHelper.GetRawPtr(x), ImportSettings.Scenes.WorldPartitionCellSize);
+			}
+			if (LoadingRangeProperty != nullptr)
+			{
+				LoadingRangeProperty->SetPropertyValue_InContainer(GridsHelper.GetRawPtr(x), ImportSettings.Scenes.WorldPartitionLoadingRange);
+			}
+		}
+		RuntimeHash->MarkPackageDirty();
+		if (CellSizeProperty != nullptr)
+		{
+			UTU_LOG_L("            Cell Size: " + FString::FromInt(ImportSettings.Scenes.WorldPartitionCellSize));
+		}
+		else
+		{
+			UTU_LOG_W("            Failed to find the cell size of the runtime grids. Default cell size will be used.");
+		}
+		if (LoadingRangeProperty != nullptr)
+		{
+			UTU_LOG_L("            Loading Range: " + FString::SanitizeFloat(ImportSettings.Scenes.WorldPartitionLoadingRange));
+		}
+		else
+		{
+			UTU_LOG_W("            Failed to find the loading range of the runtime grids. Default loading range will be used.");
+		}
+	}
+	// Streaming -- Levels created before the option existed have it disabled
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+	if (!WorldPartition->IsStreamingEnabled())
+	{
+		WorldPartition->SetEnableStreaming(true);
+		WorldPartition->MarkPackageDirty();
+		UTU_LOG_L("            Streaming enabled.");
+	}
+#else
+	FBoolProperty* EnableStreamingProperty = FindFProperty<FBoolProperty>(WorldPartition->GetClass(), "bEnableStreaming");
+	if (EnableStreamingProperty == nullptr)
+	{
+		UTU_LOG_W("            Failed to find 'bEnableStreaming' on the World Partition. Make sure streaming is enabled in the World Settings.");
+	}
+	else if (!EnableStreamingProperty->GetPropertyValue_InContainer(WorldPartition))
+	{
+		EnableStreamingProperty->SetPropertyValue_InContainer(WorldPartition, true);
+		WorldPartition->MarkPackageDirty();
+		UTU_LOG_L("            Streaming enabled.");
+	}
+#endif
+	// Actors are placed in the streaming cells by their location. Instance groups are already split per cell, see WorldSpawnInstancedStaticMeshActors.
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+	// Global actors stay always loaded
+	TArray<AActor*> GlobalActors;
+	UGameplayStatics::GetAllActorsOfClass(InAsset, ASkyLight::StaticClass(), GlobalActors);
+	UGameplayStatics::GetAllActorsOfClass(InAsset, ADirectionalLight::StaticClass(), GlobalActors);
+	for (AActor* GlobalActor : GlobalActors)
+	{
+		GlobalActor->SetIsSpatiallyLoaded(false);
+	}
+	// Data Layers
+	if (ImportSettings.Scenes.bCreateDataLayersFromTags)
+	{
+		UDataLayerEditorSubsystem* DataLayerSubsystem = UDataLayerEditorSubsystem::Get();
+		AWorldDataLayers* WorldDataLayers = InAsset->GetWorldDataLayers();
+		TMap<FString, UDataLayerInstance*> TagToDataLayer;
+		TSet<AActor*> ActorsInDataLayers;
+		for (const FUtuPluginActor& UtuActor : InUtuActors)
+		{
+			const AActor* const* FoundActor = InIdToActor.Find(UtuActor.actor_id);
+			AActor* Actor = FoundActor != nullptr ? const_cast<AActor*>(*FoundActor) : nullptr;
+			// Instance groups are split per tag, so the first instance gives the tag of the whole group
+			bool bAlreadyInDataLayer = false;
+			if (Actor != nullptr)
+			{
+				ActorsInDataLayers.Add(Actor, &bAlreadyInDataLayer);
+			}
+			if (Actor == nullptr || bAlreadyInDataLayer || UtuActor.actor_tag == "Untagged" || UtuActor.actor_tag.IsEmpty() || DataLayerSubsystem == nullptr || WorldDataLayers == nullptr)
+			{
+				continue;
+			}
+			UDataLayerInstance** DataLayerInstance = TagToDataLayer.Find(UtuActor.actor_tag);
+			if (DataLayerInstance == nullptr)
+			{
+				FString DataLayerName = "DL_" + ObjectTools::SanitizeObjectName(UtuActor.actor_tag);
+				FString DataLayerRelativeFilename = "/Game/Utu/DataLayers/" + DataLayerName;
+				UDataLayerAsset* DataLayerAsset = Cast<UDataLayerAsset>(UUtuPluginLibrary::TryGetAsset(DataLayerRelativeFilename));
+				if (DataLayerAsset == nullptr)
+				{
+					UPackage* Package = CreateAssetPackage(DataLayerRelativeFilename, false);
+					DataLayerAsset = NewObject<UDataLayerAsset>(Package, *DataLayerName, RF_Public | RF_Standalone | RF_Transactional);
+					DataLayerAsset->SetType(EDataLayerType::Runtime);
+					FAssetRegistryModule::AssetCreated(DataLayerAsset);
+					DataLayerAsset->MarkPackageDirty();
+					UTU_LOG_L("            Data Layer created: '" + DataLayerRelativeFilename + "'");
+				}
+				UDataLayerInstance* NewDataLayerInstance = WorldDataLayers->GetDataLayerInstance(DataLayerAsset);
+				if (NewDataLayerInstance == nullptr)
+				{
+					FDataLayerCreationParameters Parameters;
+					Parameters.DataLayerAsset = DataLayerAsset;
+					Parameters.WorldDataLayers = WorldDataLayers;
+					NewDataLayerInstance = DataLayerSubsystem->CreateDataLayerInstance(Parameters);
+				}
+				DataLayerInstance = &TagToDataLayer.Add(UtuActor.actor_tag, NewDataLayerInstance);
+			}
+			if (*DataLayerInstance != nullptr)
+			{
+				DataLayerSubsystem->AddActorToDataLayer(Actor, *DataLayerInstance);
+			}
+		}
+		UTU_LOG_L("            " + FString::FromInt(TagToDataLayer.Num()) + " data layers used by the imported actors.");
 	}
-	return RetActor;
+#endif
+#else
+	UTU_LOG_W("        World Partition requires Unreal Engine 5. The level was imported as a regular level.");
+#endif
 }
 
-AActor* FUtuPluginAssetTypeProcessor::WorldSpawnStaticMeshActor(UWorld * InAsset, FUtuPluginActor InUtuActor) {
-	UTU_LOG_L("            Adding Static Mesh Actor...");
-	UTU_LOG_L("                Actor Name: '" + InUtuActor.actor_display_name + "'");
-	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
-	UTU_LOG_L("                Actor Class: 'AStaticMeshActor'");
-	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
+FString FUtuPluginAssetTypeProcessor::WorldGetActorSignature(FUtuPluginActor InUtuActor)
+{
+	// Only what can't be updated in place
+	bool bPlainStaticMesh = InUtuActor.actor_types.Num() == 1 && InUtuActor.actor_types[0] == EUtuActorType::StaticMesh;
+	InUtuActor.actor_id = 0;
+	InUtuActor.actor_parent_id = 0;
+	InUtuActor.actor_display_name = "";
+	InUtuActor.actor_is_visible = false;
+	InUtuActor.actor_world_location = FVector();
+	InUtuActor.actor_world_rotation = FQuat();
+	InUtuActor.actor_world_scale = FVector();
+	InUtuActor.actor_relative_location = FVector();
+	InUtuActor.actor_relative_rotation = FQuat();
+	InUtuActor.actor_relative_scale = FVector();
+	if (bPlainStaticMesh)
+	{
+		InUtuActor.actor_mesh = FUtuPluginActorMesh();
+	}
+	FString JsonString;
+	FJsonObjectConverter::UStructToJsonObjectString(InUtuActor, JsonString, 0, 0, 0, nullptr, false);
+	return FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*JsonString));
+}
 
-	// Check if not LOD
-	if (ImportSettings.StaticMeshes.bUtuGenerateLODs)
+FString FUtuPluginAssetTypeProcessor::WorldGetActorMeshSignature(FUtuPluginActor InUtuActor)
+{
+	FString JsonString;
+	FJsonObjectConverter::UStructToJsonObjectString(InUtuActor.actor_mesh, JsonString, 0, 0, 0, nullptr, false);
+	return FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*JsonString));
+}
+
+int FUtuPluginAssetTypeProcessor::GetActorUtuId(AActor* InActor)
+{
+	// The plain numeric tag can't be told apart from a numeric Unity tag
+	FString Id = GetActorTagValue(InActor, "UtuId_");
+	if (Id.IsNumeric())
 	{
-		TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InUtuActor.actor_mesh.actor_mesh_relative_filename, EUtuUnrealAssetType::StaticMesh);
-		if (MeshNames[1].Contains("_LOD"))
+		return FCString::Atoi(*Id);
+	}
+	return UtuConst::INVALID_INT;
+}
+
+FString FUtuPluginAssetTypeProcessor::GetActorTagValue(AActor* InActor, FString InPrefix)
+{
+	for (const FName& Tag : InActor->Tags)
+	{
+		FString TagString = Tag.ToString();
+		if (TagString.StartsWith(InPrefix))
 		{
-			FString LodIndex = "";
-			MeshNames[1].Split("_LOD", nullptr, &LodIndex, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+			return TagString.RightChop(InPrefix.Len());
+		}
+	}
+	return "";
+}
+
+void FUtuPluginAssetTypeProcessor::SetActorTagValue(AActor* InActor, FString InPrefix, FString InValue)
+{
+	InActor->Tags.RemoveAll([&InPrefix](const FName& Tag) { return Tag.ToString().StartsWith(InPrefix); });
+	InActor->Tags.Add(*(InPrefix + InValue));
+}
 
-			if (LodIndex.IsNumeric() && LodIndex != "0") // Keep main LOD
+TArray<int> FUtuPluginAssetTypeProcessor::GetInstancesActorIds(UInstancedStaticMeshComponent* InComponent)
+{
+	TArray<int> Ids;
+	if (InComponent != nullptr && InComponent->ComponentTags.Num() > 0 && InComponent->ComponentTags[0] == "UtuInstances")
+	{
+		for (int x = 1; x < InComponent->ComponentTags.Num(); x++)
+		{
+			FString Id;
+			if (!InComponent->ComponentTags[x].ToString().Split("|", &Id, nullptr))
 			{
-				UTU_LOG_L("                Actor skipped because it's a LOD and not a real mesh. LODs should already be included in LOD0 of this mesh.");
-				return nullptr;
+				Id = InComponent->ComponentTags[x].ToString(); // Instances imported before the tag and name were stored
 			}
+			Ids.Add(FCString::Atoi(*Id));
 		}
 	}
+	return Ids;
+}
 
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AStaticMeshActor* RetActor = InAsset->SpawnActor<AStaticMeshActor>(Params);
-	if (RetActor != nullptr) {
-		TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InUtuActor.actor_mesh.actor_mesh_relative_filename, EUtuUnrealAssetType::StaticMesh);
-		TArray<FString> MeshNamesSeparated = FormatRelativeFilenameForUnrealSeparated(InUtuActor.actor_mesh.actor_mesh_relative_filename, InUtuActor.actor_mesh.actor_mesh_relative_filename_if_separated, EUtuUnrealAssetType::StaticMesh);
-		UTU_LOG_L("            Associating Static Mesh to Static Mesh Actor...");
-		UTU_LOG_L("                Unreal Asset Relative Path: " + MeshNames[2]);
-		UTU_LOG_L("                Unreal Asset Relative Path If Separated: " + MeshNamesSeparated[2]);
-		UStaticMesh* StaticMeshAsset = GetMeshAsset(ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames);
-		if (StaticMeshAsset == nullptr) {
-			StaticMeshAsset = GetMeshAsset(!ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames);
-		}
-		if (StaticMeshAsset == nullptr) {
-			UTU_LOG_W("                Failed to assign Static Mesh because it doesn't exists: '" + (ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames)[2] + "'");
-		}
-		RetActor->GetStaticMeshComponent()->SetStaticMesh(StaticMeshAsset);
-		AssignMaterialsToMesh(InUtuActor.actor_mesh.actor_mesh_materials_relative_filenames, RetActor->GetStaticMeshComponent());
-		RetActor->SetActorLabel(InUtuActor.actor_display_name);
-	}
-	else {
-		UTU_LOG_E("            Failed to spawn StaticMesh Actor...");
-		UTU_LOG_E("                Actor Name: '" + InUtuActor.actor_display_name + "'");
-		UTU_LOG_E("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
-		UTU_LOG_E("                Potential Causes:");
-		UTU_LOG_E("                    - No Potential Causes known yet, but it should never happen.");
-	}
-	return RetActor;
+FName FUtuPluginAssetTypeProcessor::MakeInstanceTag(FUtuPluginActor InUtuActor)
+{
+	FString Tag = InUtuActor.actor_tag != "Untagged" ? InUtuActor.actor_tag : "";
+	return FName(*(FString::FromInt(InUtuActor.actor_id) + "|" + Tag + "|" + InUtuActor.actor_display_name));
 }
 
 AActor* FUtuPluginAssetTypeProcessor::WorldSpawnSkeletalMeshActor(UWorld * InAsset, FUtuPluginActor InUtuActor) {
@@ -2456,9 +4135,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnSkeletalMeshActor(UWorld * InAss
 	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 	UTU_LOG_L("                Actor Class: 'ASkeletalMeshActor'");
 	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	ASkeletalMeshActor* RetActor = InAsset->SpawnActor<ASkeletalMeshActor>(Params);
+	ASkeletalMeshActor* RetActor = Cast<ASkeletalMeshActor>(WorldSpawnActor(InAsset, ASkeletalMeshActor::StaticClass()));
 	if (RetActor != nullptr && RetActor->GetSkeletalMeshComponent() != nullptr) {
 		TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InUtuActor.actor_mesh.actor_mesh_relative_filename, EUtuUnrealAssetType::SkeletalMesh);
 		UTU_LOG_L("            Associating Skeletal Mesh to Skeletal Mesh Actor...");
@@ -2518,9 +4195,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnBlueprintActor(UWorld * InAsset,
 	UBlueprint* BlueprintAsset = Cast<UBlueprint>(UUtuPluginLibrary::TryGetAsset(BpNames[2]));
 	if (BlueprintAsset != nullptr) 
 	{
-		FActorSpawnParameters Params = FActorSpawnParameters();
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		RetActor = InAsset->SpawnActor<AActor>(BlueprintAsset->GeneratedClass, Params);
+		RetActor = WorldSpawnActor(InAsset, BlueprintAsset->GeneratedClass);
 		if (RetActor != nullptr) 
 		{
 			RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -2528,6 +4203,11 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnBlueprintActor(UWorld * InAsset,
 			if (Comps.Num() > 0) 
 			{
 				UTU_LOG_L("                Applying scene overrides if needed...");
+				bool bPacked = RetActor->FindComponentByClass<UInstancedStaticMeshComponent>() != nullptr;
+				if (bPacked && InUtuActor.actor_prefab.actor_prefab_component_overrides.Num() > 0)
+				{
+					UTU_LOG_W("                Scene overrides are ignored because the Blueprint is packed into instanced components: '" + BpNames[2] + "'");
+				}
 				for (FUtuPluginActorPrefabComponentOverride Override : InUtuActor.actor_prefab.actor_prefab_component_overrides) 
 				{
 					for (UActorComponent* Comp : Comps)
@@ -2595,7 +4275,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnBlueprintActor(UWorld * InAsset,
 				}
 
 				// Replace prefab by SM if that's what we want 
-				if (ImportSettings.Scenes.MeshSpawnBehavior != EUtuMeshSpawnBehavior::AllPrefab)
+				if (ImportSettings.Scenes.MeshSpawnBehavior != EUtuMeshSpawnBehavior::AllPrefab && !bPacked)
 				{
 					TArray<USceneComponent*> SceneComps = TArray<USceneComponent*>();
 					TArray<UStaticMeshComponent*> StaticMeshComps = TArray<UStaticMeshComponent*>();
@@ -2619,7 +4299,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnBlueprintActor(UWorld * InAsset,
 							if (StaticMeshComps.Num() == 1 && StaticMeshComps[0]->GetRelativeTransform().Equals(FTransform::Identity))
 							{
 								// We don't
-								AStaticMeshActor* MeshActor = InAsset->SpawnActor<AStaticMeshActor>(Params);
+								AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(WorldSpawnActor(InAsset, AStaticMeshActor::StaticClass()));
 								if (MeshActor != nullptr)
 								{
 									if (MeshActor->GetStaticMeshComponent() != nullptr)
@@ -2645,19 +4325,19 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnBlueprintActor(UWorld * InAsset,
 							{
 								// We do
 								// Create Empty Root Actor
-								AActor* RootActor = InAsset->SpawnActor<AActor>(Params);
+								AActor* RootActor = WorldSpawnActor(InAsset, AActor::StaticClass());
 								if (RootActor != nullptr) {
 									USceneComponent* RootComponent = NewObject<USceneComponent>(RootActor, USceneComponent::GetDefaultSceneRootVariableName(), RF_Transactional);
 									if (RootComponent != nullptr) {
 										RootActor->SetRootComponent(RootComponent);
 										RootActor->AddInstanceComponent(RootComponent);
-										RootComponent->RegisterComponent();
+										WorldRegisterComponent(RootComponent);
 										RootComponent->SetMobility(InUtuActor.actor_is_movable ? EComponentMobility::Movable : EComponentMobility::Static);
 
 										// Spawn meshes
 										for (UStaticMeshComponent* SmComp : StaticMeshComps)
 										{
-											AStaticMeshActor* MeshActor = InAsset->SpawnActor<AStaticMeshActor>(Params);
+											AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(WorldSpawnActor(InAsset, AStaticMeshActor::StaticClass()));
 											if (MeshActor != nullptr)
 											{
 												if (MeshActor->GetStaticMeshComponent() != nullptr)
@@ -2713,9 +4393,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnSkyLightActor(UWorld * InAsset)
 	UTU_LOG_L("            Adding Point Sky Actor...");
 	UTU_LOG_L("                Actor Name: 'SkyLight'");
 	UTU_LOG_L("                Actor Class: 'ASkyLight'");
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	ASkyLight* RetActor = InAsset->SpawnActor<ASkyLight>(ASkyLight::StaticClass(), Params);
+	ASkyLight* RetActor = Cast<ASkyLight>(WorldSpawnActor(InAsset, ASkyLight::StaticClass()));
 	if (RetActor != nullptr && Cast<USkyLightComponent>(RetActor->GetLightComponent()) != nullptr) {
 		USkyLightComponent* Comp = Cast<USkyLightComponent>(RetActor->GetLightComponent());
 		RetActor->Tags.Add("UtuActor");
@@ -2741,9 +4419,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnPointLightActor(UWorld * InAsset
 	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 	UTU_LOG_L("                Actor Class: 'APointLight'");
 	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	APointLight* RetActor = InAsset->SpawnActor<APointLight>(APointLight::StaticClass(), Params);
+	APointLight* RetActor = Cast<APointLight>(WorldSpawnActor(InAsset, APointLight::StaticClass()));
 	if (RetActor != nullptr && Cast<UPointLightComponent>(RetActor->GetLightComponent()) != nullptr) {
 		UPointLightComponent* Comp = Cast<UPointLightComponent>(RetActor->GetLightComponent());
 		RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -2772,9 +4448,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnDirectionalLightActor(UWorld * I
 	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 	UTU_LOG_L("                Actor Class: 'ADirectionalLight'");
 	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	ADirectionalLight* RetActor = InAsset->SpawnActor<ADirectionalLight>(ADirectionalLight::StaticClass(), Params);
+	ADirectionalLight* RetActor = Cast<ADirectionalLight>(WorldSpawnActor(InAsset, ADirectionalLight::StaticClass()));
 	if (RetActor != nullptr && RetActor->GetLightComponent() != nullptr) {
 		ULightComponent* Comp = RetActor->GetLightComponent();
 		RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -2798,9 +4472,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnSpotLightActor(UWorld * InAsset,
 	UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 	UTU_LOG_L("                Actor Class: 'ASpotLight'");
 	UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	ASpotLight* RetActor = InAsset->SpawnActor<ASpotLight>(ASpotLight::StaticClass(), Params);
+	ASpotLight* RetActor = Cast<ASpotLight>(WorldSpawnActor(InAsset, ASpotLight::StaticClass()));
 	if (RetActor != nullptr && Cast<USpotLightComponent>(RetActor->GetLightComponent()) != nullptr) {
 		USpotLightComponent* Comp = Cast<USpotLightComponent>(RetActor->GetLightComponent());
 		RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -2832,9 +4504,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnCameraActor(UWorld * InAsset, FU
 		UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 		UTU_LOG_L("                Actor Class: 'ACineCameraActor'");
 		UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-		FActorSpawnParameters Params = FActorSpawnParameters();
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		RetActor = InAsset->SpawnActor<ACineCameraActor>(ACineCameraActor::StaticClass(), Params);
+		RetActor = Cast<ACineCameraActor>(WorldSpawnActor(InAsset, ACineCameraActor::StaticClass()));
 		if (RetActor != nullptr && Cast<ACineCameraActor>(RetActor)->GetCineCameraComponent() != nullptr) {
 			UCineCameraComponent* Comp = Cast<ACineCameraActor>(RetActor)->GetCineCameraComponent();
 			RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -2870,9 +4540,7 @@ AActor* FUtuPluginAssetTypeProcessor::WorldSpawnCameraActor(UWorld * InAsset, FU
 		UTU_LOG_L("                Actor ID: " + FString::FromInt(InUtuActor.actor_id));
 		UTU_LOG_L("                Actor Class: 'ACameraActor'");
 		UTU_LOG_L("                Actor Tag: '" + InUtuActor.actor_tag + "'");
-		FActorSpawnParameters Params = FActorSpawnParameters();
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		RetActor = InAsset->SpawnActor<ACameraActor>(ACameraActor::StaticClass(), Params);
+		RetActor = Cast<ACameraActor>(WorldSpawnActor(InAsset, ACameraActor::StaticClass()));
 		if (RetActor != nullptr && Cast<ACameraActor>(RetActor)->GetCameraComponent() != nullptr) {
 			UCameraComponent* Comp = Cast<ACameraActor>(RetActor)->GetCameraComponent();
 			RetActor->SetActorLabel(InUtuActor.actor_display_name);
@@ -3530,13 +5198,8 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		FString Material = SortedMaterials[MatId];
 
 		// Get Material asset (try both material and material instance)
-		TArray<FString> MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
-		UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		if (MaterialAsset == nullptr)
-		{
-			MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::Material : EUtuUnrealAssetType::MaterialInstance);
-			MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		}
+		FString MaterialRelativeFilename;
+		UMaterialInterface* MaterialAsset = GetMaterialFromUnityRelativeFilename(Material, MaterialRelativeFilename);
 
 		// Find ID
 		FString SlotName = FString::FromInt(MatId);
@@ -3544,7 +5207,7 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		{
 			SlotName = Slots[MatId].MaterialSlotName.ToString();
 		}
-		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MatNames[2]);
+		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MaterialRelativeFilename);
 
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 0
 		// Apply material
@@ -3561,14 +5224,14 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 #endif
 		if (MaterialAsset == nullptr)
 		{
-			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MatNames[2] + "'");
+			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MaterialRelativeFilename + "'");
 		}
 	}
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 0
 	StaticMesh->SetStaticMaterials(Slots);
 #endif
 	StaticMesh->Modify();
-	StaticMesh->PostEditChange();
+	UTU_EVENT_STAGE(EUtuEventStage::PostEdit, StaticMesh->PostEditChange());
 }
 
 
@@ -3612,13 +5275,8 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		FString Material = SortedMaterials[MatId];
 
 		// Get Material asset (try both material and material instance)
-		TArray<FString> MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
-		UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		if (MaterialAsset == nullptr)
-		{
-			MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::Material : EUtuUnrealAssetType::MaterialInstance);
-			MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		}
+		FString MaterialRelativeFilename;
+		UMaterialInterface* MaterialAsset = GetMaterialFromUnityRelativeFilename(Material, MaterialRelativeFilename);
 
 		// Find ID
 		FString SlotName = FString::FromInt(MatId);
@@ -3626,13 +5284,13 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		{
 			SlotName = Slots[MatId].MaterialSlotName.ToString();
 		}
-		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MatNames[2]);
+		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MaterialRelativeFilename);
 
 		// Apply material
 		StaticMeshComponent->SetMaterial(MatId, MaterialAsset);
 		if (MaterialAsset == nullptr)
 		{
-			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MatNames[2] + "'");
+			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MaterialRelativeFilename + "'");
 		}
 	}
 }
@@ -3685,13 +5343,8 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		FString Material = SortedMaterials[MatId];
 
 		// Get Material asset (try both material and material instance)
-		TArray<FString> MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
-		UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		if (MaterialAsset == nullptr)
-		{
-			MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::Material : EUtuUnrealAssetType::MaterialInstance);
-			MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		}
+		FString MaterialRelativeFilename;
+		UMaterialInterface* MaterialAsset = GetMaterialFromUnityRelativeFilename(Material, MaterialRelativeFilename);
 
 		// Find ID
 		FString SlotName = FString::FromInt(MatId);
@@ -3699,7 +5352,7 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		{
 			SlotName = Slots[MatId].MaterialSlotName.ToString();
 		}
-		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MatNames[2]);
+		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MaterialRelativeFilename);
 
 		// Apply material
 		while (SkeletalMesh->Materials.Num() <= MatId)
@@ -3712,12 +5365,12 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		}
 		if (MaterialAsset == nullptr)
 		{
-			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MatNames[2] + "'");
+			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MaterialRelativeFilename + "'");
 		}
 	}
 
 	SkeletalMesh->Modify();
-	SkeletalMesh->PostEditChange();
+	UTU_EVENT_STAGE(EUtuEventStage::PostEdit, SkeletalMesh->PostEditChange());
 }
 
 void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materials, USkeletalMeshComponent* SkeletalMeshComponent)
@@ -3764,13 +5417,8 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		FString Material = SortedMaterials[MatId];
 
 		// Get Material asset (try both material and material instance)
-		TArray<FString> MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
-		UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		if (MaterialAsset == nullptr)
-		{
-			MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::Material : EUtuUnrealAssetType::MaterialInstance);
-			MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
-		}
+		FString MaterialRelativeFilename;
+		UMaterialInterface* MaterialAsset = GetMaterialFromUnityRelativeFilename(Material, MaterialRelativeFilename);
 
 		// Find ID
 		FString SlotName = FString::FromInt(MatId);
@@ -3778,15 +5426,439 @@ void FUtuPluginAssetTypeProcessor::AssignMaterialsToMesh(TArray<FString> Materia
 		{
 			SlotName = Slots[MatId].MaterialSlotName.ToString();
 		}
-		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MatNames[2]);
+		UTU_LOG_L("                    MaterialSlot[" + SlotName + "] : " + MaterialRelativeFilename);
 
 		// Apply material
 		SkeletalMeshComponent->SetMaterial(MatId, MaterialAsset);
 		if (MaterialAsset == nullptr)
 		{
-			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MatNames[2] + "'");
+			UTU_LOG_W("                        Failed to assign material because it doesn't exists: '" + MaterialRelativeFilename + "'");
+		}
+	}
+}
+
+UMaterialInterface* FUtuPluginAssetTypeProcessor::GetMaterialFromUnityRelativeFilename(FString InUnityRelativeFilename, FString& OutAssetRelativeFilename)
+{
+	FString Material = GetMaterialRedirect(InUnityRelativeFilename);
+	TArray<FString> MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material);
+	UMaterialInterface* MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
+	if (MaterialAsset == nullptr)
+	{
+		MatNames = FormatRelativeFilenameForUnreal(Material, ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::Material : EUtuUnrealAssetType::MaterialInstance);
+		MaterialAsset = Cast<UMaterialInterface>(UUtuPluginLibrary::TryGetAsset(MatNames[2]));
+	}
+	OutAssetRelativeFilename = MatNames[2];
+	return MaterialAsset;
+}
+
+void FUtuPluginAssetTypeProcessor::BuildMaterialRedirects()
+{
+	// Deterministic: the first material of each fingerprint in the json order is the one that gets created
+	MaterialRedirects.Empty();
+	TMap<FString, FString> FingerprintToMaterial;
+	for (const FUtuPluginMaterial& UtuMaterial : json.materials)
+	{
+		if (UtuMaterial.asset_relative_filename.StartsWith("Resources")) // Default Unity Material
+		{
+			continue;
+		}
+		FString Fingerprint = GetMaterialFingerprint(UtuMaterial);
+		const FString* Existing = FingerprintToMaterial.Find(Fingerprint);
+		if (Existing == nullptr)
+		{
+			FingerprintToMaterial.Add(Fingerprint, UtuMaterial.asset_relative_filename);
+		}
+		else if (*Existing != UtuMaterial.asset_relative_filename)
+		{
+			MaterialRedirects.Add(UtuMaterial.asset_relative_filename, *Existing);
+		}
+	}
+	if (assetType == EUtuAssetType::Material && MaterialRedirects.Num() > 0)
+	{
+		UTU_LOG_L("Material Deduplication: " + FString::FromInt(MaterialRedirects.Num()) + " materials collapsed into " + FString::FromInt(FingerprintToMaterial.Num()) + " unique material instances.");
+		for (const TPair<FString, FString>& Redirect : MaterialRedirects)
+		{
+			UTU_LOG_L("    '" + Redirect.Key + "' -> '" + Redirect.Value + "'");
+		}
+	}
+}
+
+FString FUtuPluginAssetTypeProcessor::GetMaterialFingerprint(FUtuPluginMaterial InUtuMaterial)
+{
+	// Parameters are sorted by name so the order they were exported in doesn't matter
+	TArray<FString> Parameters;
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_floats_names.Num(), InUtuMaterial.material_floats.Num()); Idx++)
+	{
+		Parameters.Add("F:" + InUtuMaterial.material_floats_names[Idx] + "=" + FString::SanitizeFloat(InUtuMaterial.material_floats[Idx]));
+	}
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_ints_names.Num(), InUtuMaterial.material_ints.Num()); Idx++)
+	{
+		Parameters.Add("I:" + InUtuMaterial.material_ints_names[Idx] + "=" + FString::FromInt(InUtuMaterial.material_ints[Idx]));
+	}
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_textures_names.Num(), InUtuMaterial.material_textures.Num()); Idx++)
+	{
+		Parameters.Add("T:" + InUtuMaterial.material_textures_names[Idx] + "=" + GetTextureRedirect(InUtuMaterial.material_textures[Idx]));
+	}
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_colors_names.Num(), InUtuMaterial.material_colors.Num()); Idx++)
+	{
+		Parameters.Add("C:" + InUtuMaterial.material_colors_names[Idx] + "=" + HexToColor(InUtuMaterial.material_colors[Idx]).ToString());
+	}
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vectors_names.Num(), InUtuMaterial.material_vectors.Num()); Idx++)
+	{
+		FQuat Value = InUtuMaterial.material_vectors[Idx];
+		Parameters.Add("V:" + InUtuMaterial.material_vectors_names[Idx] + "=" + FLinearColor(Value.X, Value.Y, Value.Z, Value.W).ToString());
+	}
+	for (int Idx = 0; Idx < FMath::Min(InUtuMaterial.material_vector2s_names.Num(), InUtuMaterial.material_vector2s.Num()); Idx++)
+	{
+		Parameters.Add("V2:" + InUtuMaterial.material_vector2s_names[Idx] + "=" + InUtuMaterial.material_vector2s[Idx].ToString());
+	}
+	Parameters.Sort();
+
+	FString Fingerprint = InUtuMaterial.shader_name;
+	Fingerprint += "|" + FString::FromInt((int)InUtuMaterial.shader_opacity);
+	Fingerprint += "|" + FString(InUtuMaterial.two_sided ? "1" : "0");
+	Fingerprint += "|" + GetTextureRedirect(InUtuMaterial.main_texture);
+	Fingerprint += "|" + InUtuMaterial.main_texture_scale.ToString() + "|" + InUtuMaterial.main_texture_offset.ToString();
+	Fingerprint += "|" + HexToColor(InUtuMaterial.main_color).ToString();
+	Fingerprint += "|" + FString::Join(Parameters, TEXT("|"));
+	return Fingerprint;
+}
+
+void FUtuPluginAssetTypeProcessor::BuildTextureRedirects()
+{
+	// Done once per import, the result is shared with the other phases through the import cache
+	double StartTime = FPlatformTime::Seconds();
+	ImportCache->bTextureRedirectsBuilt = true;
+	ImportCache->TextureRedirects.Empty();
+	ImportCache->TextureRedirectsSavedBytes = 0;
+
+	TArray<FString> Hashes;
+	TArray<int64> Sizes;
+	Hashes.SetNum(json.textures.Num());
+	Sizes.SetNum(json.textures.Num());
+	ParallelFor(json.textures.Num(), [this, &Hashes, &Sizes](int32 Index)
+	{
+		const FString& Filename = json.textures[Index].texture_file_absolute_filename;
+		Sizes[Index] = IFileManager::Get().FileSize(*Filename);
+		if (Sizes[Index] > 0)
+		{
+			Hashes[Index] = LexToString(FMD5Hash::HashFile(*Filename));
+		}
+	});
+
+	// Deterministic: the first texture of each hash in the json order is the one that gets imported
+	TMap<FString, FString> HashToTexture;
+	for (int Index = 0; Index < json.textures.Num(); Index++)
+	{
+		if (Hashes[Index] == "")
+		{
+			continue;
+		}
+		FString Key = Hashes[Index] + "|" + FString::Printf(TEXT("%lld"), Sizes[Index]) + "|" + FPaths::GetExtension(json.textures[Index].texture_file_absolute_filename);
+		const FString* Existing = HashToTexture.Find(Key);
+		if (Existing == nullptr)
+		{
+			HashToTexture.Add(Key, json.textures[Index].asset_relative_filename);
+		}
+		else if (*Existing != json.textures[Index].asset_relative_filename)
+		{
+			ImportCache->TextureRedirects.Add(json.textures[Index].asset_relative_filename, *Existing);
+			ImportCache->TextureRedirectsSavedBytes += Sizes[Index];
+		}
+	}
+	UTU_LOG_L("Texture Deduplication: " + FString::FromInt(json.textures.Num()) + " textures hashed in " + FString::SanitizeFloat(FPlatformTime::Seconds() - StartTime) + " seconds, " + FString::FromInt(ImportCache->TextureRedirects.Num()) + " duplicates found.");
+	for (const TPair<FString, FString>& Redirect : ImportCache->TextureRedirects)
+	{
+		UTU_LOG_L("    '" + Redirect.Key + "' -> '" + Redirect.Value + "'");
+	}
+}
+
+void FUtuPluginAssetTypeProcessor::ProcessNonPowerOfTwoTexture(UTexture2D* InTexture, FString InUnityRelativeFilename)
+{
+	FString Size = FString::FromInt(InTexture->Source.GetSizeX()) + "x" + FString::FromInt(InTexture->Source.GetSizeY());
+	FString Action = "Kept as is. No mips and no streaming.";
+	EUtuNonPowerOfTwoBehavior Behavior = ImportSettings.Textures.NonPowerOfTwoBehavior;
+	if (Behavior == EUtuNonPowerOfTwoBehavior::PadToPowerOfTwo && !CanScaleTextureCoordinates(InUnityRelativeFilename))
+	{
+		UTU_LOG_W("        Non power of two texture (" + Size + ") can't be padded because the UVs of a material using it can't be scaled. Resizing it instead.");
+		UTU_LOG_W("            Potential Causes:");
+		UTU_LOG_W("                - 'bCreateMaterialInstances' is disabled, or a material tiles or offsets it, samples it as its main texture or without tiling and offset.");
+		Behavior = EUtuNonPowerOfTwoBehavior::ResizeToPowerOfTwo;
+	}
+	if (Behavior == EUtuNonPowerOfTwoBehavior::ResizeToPowerOfTwo)
+	{
+		if (ResizeTextureToPowerOfTwo(InTexture))
+		{
+			InTexture->PowerOfTwoMode = ETexturePowerOfTwoSetting::None;
+			Action = "Resized to " + FString::FromInt(InTexture->Source.GetSizeX()) + "x" + FString::FromInt(InTexture->Source.GetSizeY()) + ".";
+		}
+		else if (ImportSettings.Textures.NonPowerOfTwoBehavior == EUtuNonPowerOfTwoBehavior::ResizeToPowerOfTwo && CanScaleTextureCoordinates(InUnityRelativeFilename))
+		{
+			// Fallback of the unsupported resize formats
+			Behavior = EUtuNonPowerOfTwoBehavior::PadToPowerOfTwo;
+		}
+		else
+		{
+			UTU_LOG_W("        Non power of two texture (" + Size + ") kept as is because its source format can't be resized.");
+		}
+	}
+	if (Behavior == EUtuNonPowerOfTwoBehavior::PadToPowerOfTwo)
+	{
+		InTexture->PowerOfTwoMode = ETexturePowerOfTwoSetting::PadToPowerOfTwo;
+		Action = "Padded to " + FString::FromInt(FMath::RoundUpToPowerOfTwo(InTexture->Source.GetSizeX())) + "x" + FString::FromInt(FMath::RoundUpToPowerOfTwo(InTexture->Source.GetSizeY())) + ". UV scale adjusted in material instances.";
+	}
+	UTU_LOG_L("        Non power of two texture (" + Size + "): " + Action);
+	ImportCache->NonPowerOfTwoTextures.Add(InTexture->GetPathName() + " (" + Size + "): " + Action);
+}
+
+bool FUtuPluginAssetTypeProcessor::CanScaleTextureCoordinates(FString InUnityRelativeFilename)
+{
+	// The scale goes in the '<Param>_ST_TexCoord' parameter of the material instances
+	return ImportSettings.Materials.bCreateMaterialInstances && !UnpaddableTextures.Contains(InUnityRelativeFilename);
+}
+
+void FUtuPluginAssetTypeProcessor::BuildUnpaddableTextures()
+{
+	// Padding keeps the look only when every use samples the texture once over 0..1, through the tiling and offset parameters
+	UnpaddableTextures.Empty();
+	for (const FUtuPluginMaterial& UtuMaterial : json.materials)
+	{
+		if (UtuMaterial.main_texture != "")
+		{
+			UnpaddableTextures.Add(GetTextureRedirect(UtuMaterial.main_texture));
+		}
+		for (int Idx = 0; Idx < FMath::Min(UtuMaterial.material_textures_names.Num(), UtuMaterial.material_textures.Num()); Idx++)
+		{
+			if (UtuMaterial.material_textures[Idx] == "")
+			{
+				continue;
+			}
+			FString Name = UtuMaterial.material_textures_names[Idx];
+			int TexCoordIndex = UtuMaterial.material_vector2s_names.Find(Name + "_ST_TexCoord");
+			int PannerIndex = UtuMaterial.material_vector2s_names.Find(Name + "_ST_Panner");
+			bool bUntiled = UtuMaterial.material_vector2s.IsValidIndex(TexCoordIndex) && UtuMaterial.material_vector2s.IsValidIndex(PannerIndex)
+				&& UtuMaterial.material_vector2s[TexCoordIndex].Equals(FVector2D(1.0f, 1.0f)) && UtuMaterial.material_vector2s[PannerIndex].IsNearlyZero();
+			if (!bUntiled)
+			{
+				UnpaddableTextures.Add(GetTextureRedirect(UtuMaterial.material_textures[Idx]));
+			}
+		}
+	}
+	UTU_LOG_L("Textures that would sample their padding: " + FString::FromInt(UnpaddableTextures.Num()) + " (tiled, offset or sampled without tiling and offset parameters).");
+}
+
+bool FUtuPluginAssetTypeProcessor::ResizeTextureToPowerOfTwo(UTexture2D* InTexture)
+{
+	ETextureSourceFormat Format = InTexture->Source.GetFormat();
+	if (Format != TSF_BGRA8 && Format != TSF_G8)
+	{
+		return false;
+	}
+	TArray64<uint8> Source;
+	if (!InTexture->Source.GetMipData(Source, 0))
+	{
+		return false;
+	}
+	// Closest power of two on each side
+	auto ClosestPowerOfTwo = [](int32 InSize)
+	{
+		int32 Up = FMath::RoundUpToPowerOfTwo(InSize);
+		int32 Down = FMath::Max(Up / 2, 1);
+		return Up - InSize <= InSize - Down ? Up : Down;
+	};
+	int32 Channels = Format == TSF_BGRA8 ? 4 : 1;
+	int32 SourceWidth = InTexture->Source.GetSizeX();
+	int32 SourceHeight = InTexture->Source.GetSizeY();
+	int32 Width = ClosestPowerOfTwo(SourceWidth);
+	int32 Height = ClosestPowerOfTwo(SourceHeight);
+	TArray64<uint8> Resized;
+	Resized.SetNumUninitialized((int64)Width * Height * Channels);
+
+	// Bilinear, on worker threads
+	ParallelFor(Height, [&](int32 Y)
+	{
+		float V = FMath::Clamp((Y + 0.5f) * SourceHeight / Height - 0.5f, 0.0f, (float)(SourceHeight - 1));
+		int32 Y0 = FMath::FloorToInt(V);
+		int32 Y1 = FMath::Min(Y0 + 1, SourceHeight - 1);
+		float FracY = V - Y0;
+		for (int32 X = 0; X < Width; X++)
+		{
+			float U = FMath::Clamp((X + 0.5f) * SourceWidth / Width - 0.5f, 0.0f, (float)(SourceWidth - 1));
+			int32 X0 = FMath::FloorToInt(U);
+			int32 X1 = FMath::Min(X0 + 1, SourceWidth - 1);
+			float FracX = U - X0;
+			for (int32 Channel = 0; Channel < Channels; Channel++)
+			{
+				float Top = FMath::Lerp((float)Source[((int64)Y0 * SourceWidth + X0) * Channels + Channel], (float)Source[((int64)Y0 * SourceWidth + X1) * Channels + Channel], FracX);
+				float Bottom = FMath::Lerp((float)Source[((int64)Y1 * SourceWidth + X0) * Channels + Channel], (float)Source[((int64)Y1 * SourceWidth + X1) * Channels + Channel], FracX);
+				Resized[((int64)Y * Width + X) * Channels + Channel] = (uint8)FMath::Clamp(FMath::RoundToInt(FMath::Lerp(Top, Bottom, FracY)), 0, 255);
+			}
+		}
+	});
+	InTexture->Source.Init(Width, Height, 1, 1, Format, Resized.GetData());
+	return true;
+}
+
+void FUtuPluginAssetTypeProcessor::ApplyPaddedTextureScale(FUtuMaterialInstanceTarget& InOutTarget)
+{
+	// Padding is added on the right and bottom, so only the part of the UVs covering the original texels must be used
+	for (const TPair<FName, UTexture*>& Texture : InOutTarget.Textures)
+	{
+		UTexture2D* Texture2D = Cast<UTexture2D>(Texture.Value);
+		if (Texture2D == nullptr || Texture2D->PowerOfTwoMode != ETexturePowerOfTwoSetting::PadToPowerOfTwo)
+		{
+			continue;
+		}
+		int32 SizeX = Texture2D->Source.GetSizeX();
+		int32 SizeY = Texture2D->Source.GetSizeY();
+		float ScaleX = (float)SizeX / FMath::RoundUpToPowerOfTwo(SizeX);
+		float ScaleY = (float)SizeY / FMath::RoundUpToPowerOfTwo(SizeY);
+		FLinearColor& TexCoord = InOutTarget.Vectors.FindOrAdd(FName(Texture.Key.ToString() + "_ST_TexCoord"), FLinearColor(1.0f, 1.0f, 0.0f, 0.0f));
+		TexCoord.R *= ScaleX;
+		TexCoord.G *= ScaleY;
+		if (FLinearColor* Panner = InOutTarget.Vectors.Find(FName(Texture.Key.ToString() + "_ST_Panner")))
+		{
+			Panner->R *= ScaleX;
+			Panner->G *= ScaleY;
+		}
+	}
+}
+
+void FUtuPluginAssetTypeProcessor::AnalyzeTexelDensity()
+{
+	// Runs after the textures and after the meshes, only the textures whose every use is known are changed
+	UTU_LOG_SEPARATOR_LINE();
+	UTU_LOG_L("Analyzing texel density...");
+	// Textures of each material with their tiling, a tiled texture repeats over a smaller world size
+	TMap<FString, TArray<TPair<FString, float>>> MaterialToTextures;
+	for (const FUtuPluginMaterial& UtuMaterial : json.materials)
+	{
+		TArray<TPair<FString, float>>& Textures = MaterialToTextures.Add(UtuMaterial.asset_relative_filename);
+		if (UtuMaterial.main_texture != "")
+		{
+			Textures.Add(TPair<FString, float>(GetTextureRedirect(UtuMaterial.main_texture), UtuMaterial.main_texture_scale.GetAbsMax()));
+		}
+		for (int Idx = 0; Idx < FMath::Min(UtuMaterial.material_textures_names.Num(), UtuMaterial.material_textures.Num()); Idx++)
+		{
+			if (UtuMaterial.material_textures[Idx] != "")
+			{
+				int TexCoordIndex = UtuMaterial.material_vector2s_names.Find(UtuMaterial.material_textures_names[Idx] + "_ST_TexCoord");
+				float Tiling = UtuMaterial.material_vector2s.IsValidIndex(TexCoordIndex) ? UtuMaterial.material_vector2s[TexCoordIndex].GetAbsMax() : 1.0f;
+				Textures.Add(TPair<FString, float>(GetTextureRedirect(UtuMaterial.material_textures[Idx]), Tiling));
+			}
+		}
+	}
+
+	// Largest world size one repeat of each texture covers, -1 when one of its uses can't be measured
+	TMap<FString, float> TextureToWorldSize;
+	TMap<FString, UStaticMesh*> MeshCache;
+	auto AddUse = [&](const FUtuPluginActor& InUtuActor)
+	{
+		if (InUtuActor.actor_mesh.actor_mesh_relative_filename == "")
+		{
+			return;
+		}
+		FString MeshKey = InUtuActor.actor_mesh.actor_mesh_relative_filename + "|" + InUtuActor.actor_mesh.actor_mesh_relative_filename_if_separated;
+		if (!MeshCache.Contains(MeshKey))
+		{
+			TArray<FString> MeshNames = FormatRelativeFilenameForUnreal(InUtuActor.actor_mesh.actor_mesh_relative_filename, EUtuUnrealAssetType::StaticMesh);
+			TArray<FString> MeshNamesSeparated = FormatRelativeFilenameForUnrealSeparated(InUtuActor.actor_mesh.actor_mesh_relative_filename, InUtuActor.actor_mesh.actor_mesh_relative_filename_if_separated, EUtuUnrealAssetType::StaticMesh);
+			UStaticMesh* Mesh = GetMeshAsset(ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames);
+			MeshCache.Add(MeshKey, Mesh != nullptr ? Mesh : GetMeshAsset(!ImportSettings.StaticMeshes.bImportSeparated ? MeshNamesSeparated : MeshNames));
+		}
+		UStaticMesh* Mesh = MeshCache[MeshKey];
+		float ActorScale = (float)UtuConst::ConvertScale(InUtuActor.actor_world_scale).GetAbsMax();
+		for (int MaterialIndex = 0; MaterialIndex < InUtuActor.actor_mesh.actor_mesh_materials_relative_filenames.Num(); MaterialIndex++)
+		{
+			// World size covered by one UV unit of the section, so atlases used by small UV islands aren't measured with the whole mesh
+			float UVWorldSize = -1.0f;
+			const FMeshUVChannelInfo* UVChannelData = Mesh != nullptr ? Mesh->GetUVChannelData(MaterialIndex) : nullptr;
+			if (UVChannelData != nullptr && UVChannelData->bInitialized && UVChannelData->LocalUVDensities[0] > 0.0f)
+			{
+				UVWorldSize = UVChannelData->LocalUVDensities[0] * ActorScale;
+			}
+			for (const TPair<FString, float>& Texture : MaterialToTextures.FindRef(InUtuActor.actor_mesh.actor_mesh_materials_relative_filenames[MaterialIndex]))
+			{
+				float WorldSize = UVWorldSize >= 0.0f && Texture.Value > 0.0f ? UVWorldSize / Texture.Value : -1.0f;
+				float* Existing = TextureToWorldSize.Find(Texture.Key);
+				if (Existing == nullptr)
+				{
+					TextureToWorldSize.Add(Texture.Key, WorldSize);
+				}
+				else if (*Existing >= 0.0f)
+				{
+					*Existing = WorldSize < 0.0f ? -1.0f : FMath::Max(*Existing, WorldSize);
+				}
+			}
+		}
+	};
+	for (const FUtuPluginScene& UtuScene : json.scenes)
+	{
+		for (const FUtuPluginActor& UtuActor : UtuScene.scene_actors)
+		{
+			AddUse(UtuActor);
+		}
+	}
+	for (const FUtuPluginPrefabSecondPass& UtuPrefab : json.prefabs_second_pass)
+	{
+		for (const FUtuPluginActor& UtuComponent : UtuPrefab.prefab_components)
+		{
+			AddUse(UtuComponent);
+		}
+	}
+
+	// Smallest power of two that still reaches the target density
+	double BytesBefore = 0.0;
+	double BytesAfter = 0.0;
+	int ChangedCount = 0;
+	for (const TPair<FString, float>& Use : TextureToWorldSize)
+	{
+		UTexture2D* Texture = Cast<UTexture2D>(UUtuPluginLibrary::TryGetAsset(FormatRelativeFilenameForUnreal(Use.Key, EUtuUnrealAssetType::Texture)[2]));
+		if (Texture == nullptr || Use.Value < 0.0f)
+		{
+			continue;
+		}
+		int32 SourceSize = FMath::Max(Texture->Source.GetSizeX(), Texture->Source.GetSizeY());
+		int32 NeededSize = FMath::RoundUpToPowerOfTwo(FMath::Max(FMath::CeilToInt(Use.Value * ImportSettings.Textures.TargetTexelDensity), ImportSettings.Textures.MinTextureSize));
+		int32 MaxSize = NeededSize >= SourceSize ? 0 : NeededSize;
+		if (ImportSettings.Textures.MaxTextureSize > 0)
+		{
+			MaxSize = MaxSize > 0 ? FMath::Min(MaxSize, ImportSettings.Textures.MaxTextureSize) : ImportSettings.Textures.MaxTextureSize;
+		}
+
+		// Projected with all mips, half a byte per texel for opaque DXT1, one byte otherwise
+		double BytesPerTexel = Texture->CompressionSettings == TC_Default && Texture->CompressionNoAlpha ? 0.5 : 1.0;
+		double Scale = MaxSize > 0 && MaxSize < SourceSize ? (double)MaxSize / SourceSize : 1.0;
+		double Bytes = (double)Texture->Source.GetSizeX() * Texture->Source.GetSizeY() * BytesPerTexel * 4.0 / 3.0;
+		BytesBefore += Bytes;
+		BytesAfter += Bytes * Scale * Scale;
+
+		if (Texture->MaxTextureSize != MaxSize)
+		{
+			UTU_LOG_L("    Texture: " + Texture->GetPathName());
+			UTU_LOG_L("        World Size Per Repeat: " + FString::SanitizeFloat(Use.Value) + " cm, Source Size: " + FString::FromInt(SourceSize) + ", Max Texture Size: " + FString::FromInt(MaxSize));
+			Texture->PreEditChange(NULL);
+			Texture->MaxTextureSize = MaxSize;
+			Texture->PostEditChange();
+			Texture->MarkPackageDirty();
+			ChangedCount++;
 		}
 	}
+	UTU_LOG_L("    Textures changed: " + FString::FromInt(ChangedCount) + " / " + FString::FromInt(TextureToWorldSize.Num()));
+	UTU_LOG_L("    Projected memory: " + FString::SanitizeFloat(BytesBefore / (1024.0 * 1024.0)) + " MB -> " + FString::SanitizeFloat(BytesAfter / (1024.0 * 1024.0)) + " MB");
+	UTU_LOG_SEPARATOR_LINE();
+}
+
+FString FUtuPluginAssetTypeProcessor::GetTextureRedirect(FString InUnityRelativeFilename)
+{
+	const FString* Redirect = ImportCache.IsValid() ? ImportCache->TextureRedirects.Find(InUnityRelativeFilename) : nullptr;
+	return Redirect != nullptr ? *Redirect : InUnityRelativeFilename;
+}
+
+FString FUtuPluginAssetTypeProcessor::GetMaterialRedirect(FString InUnityRelativeFilename)
+{
+	const FString* Redirect = MaterialRedirects.Find(InUnityRelativeFilename);
+	return Redirect != nullptr ? *Redirect : InUnityRelativeFilename;
 }
 
 UFbxImportUI* FUtuPluginAssetTypeProcessor::GetStaticMeshImportOptions(FUtuPluginMesh InUtuMesh, FString SpecificSubmesh)
@@ -3933,6 +6005,8 @@ UAssetImportTask* FUtuPluginAssetTypeProcessor::BuildTask(FString InSource, TArr
 
 TArray<FString> FUtuPluginAssetTypeProcessor::StartProcessAsset(FUtuPluginAsset InUtuAsset, EUtuUnrealAssetType AssetType) {
 	TArray<FString> RetAssetNames = FormatRelativeFilenameForUnreal(InUtuAsset.asset_relative_filename, AssetType);
+	UUtuPluginLog::SetLogContext(RetAssetNames[2]);
+	UUtuPluginLog::BeginAssetEvent(StaticEnum<EUtuUnrealAssetType>()->GetNameStringByValue((int64)AssetType), InUtuAsset.asset_relative_filename, RetAssetNames[2]);
 	UTU_LOG_EMPTY_LINE();
 	UTU_LOG_L("Asset Name: " + RetAssetNames[1]);
 	UTU_LOG_L("    Unity  Asset Relative Path: " + InUtuAsset.asset_relative_filename);
@@ -0,0 +1,324 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginBenchmark.h"
+#include "UtuPlugin/Scripts/Public/UtuPlugin.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLibrary.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginConstants.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include "Runtime/Core/Public/Misc/FileHelper.h"
+#include "Runtime/Engine/Classes/Engine/StaticMesh.h"
+#include "Runtime/JsonUtilities/Public/JsonObjectConverter.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Exporters/Exporter.h"
+#include "Exporters/FbxExportOption.h"
+#include "AssetExportTask.h"
+#include "UObject/GCObjectScopeGuard.h"
+#include "HAL/PlatformMemory.h"
+#include "Math/RandomStream.h"
+
+FString UUtuPluginBenchmark::GenerateSyntheticExport(FUtuPluginSyntheticExportSettings Settings) {
+	if (!UtuPluginPaths::isConstructed) {
+		UtuPluginPaths::ConstructUtuPluginPaths();
+	}
+	FString ExportFolder = UtuPluginPaths::pluginFolder_Full_Exports + UtuPluginPaths::slash + Settings.ExportName;
+	FString JsonFile = ExportFolder + UtuPluginPaths::slash + "UtuPlugin.json";
+	FString UnityFolder = "Assets/" + Settings.ExportName;
+	IFileManager::Get().MakeDirectory(*ExportFolder, true);
+	FRandomStream Random(Settings.Seed);
+
+	FUtuPluginJson Json;
+	FDateTime Now = FDateTime::UtcNow();
+	Json.json_info.export_name = Settings.ExportName;
+	Json.json_info.export_datetime = Now.ToString();
+	Json.json_info.export_timestamp = Now.ToString().Replace(TEXT("-"), TEXT("_")).Replace(TEXT("."), TEXT(""));
+	Json.json_info.json_file_fullname = JsonFile;
+	Json.json_info.utu_plugin_version = UUtuPlugin::GetUtuPluginVersion();
+
+	// Textures
+	for (int x = 0; x < Settings.TextureCount; x++) {
+		FUtuPluginTexture Texture;
+		Texture.asset_name = FString::Printf(TEXT("T_Synthetic_%05d"), x);
+		Texture.asset_relative_filename = UnityFolder + "/Textures/" + Texture.asset_name + ".png";
+		Texture.texture_file_absolute_filename = ExportFolder + "/Textures/" + Texture.asset_name + ".png";
+		if (!FPaths::FileExists(Texture.texture_file_absolute_filename)) {
+			WriteSyntheticTexture(Texture.texture_file_absolute_filename, Settings.TextureSize, x, Settings.Seed);
+		}
+		Json.textures.Add(Texture);
+		Json.json_info.textures.Add(Texture.asset_relative_filename);
+	}
+
+	// Materials
+	for (int x = 0; x < Settings.MaterialCount; x++) {
+		FUtuPluginMaterial Material;
+		Material.asset_name = FString::Printf(TEXT("M_Synthetic_%05d"), x);
+		Material.asset_relative_filename = UnityFolder + "/Materials/" + Material.asset_name + ".mat";
+		Material.shader_name = "Standard";
+		Material.main_color = FColor(Random.RandRange(0, 255), Random.RandRange(0, 255), Random.RandRange(0, 255), 255).ToHex();
+		Material.main_texture_scale = FVector2D(1.0f, 1.0f);
+		Material.material_colors_names.Add("_Color");
+		Material.material_colors.Add(Material.main_color);
+		Material.material_floats_names = { "_Metallic", "_Glossiness" };
+		Material.material_floats = { Random.FRand(), Random.FRand() };
+		if (Json.textures.Num() > 0) {
+			Material.main_texture = Json.textures[x % Json.textures.Num()].asset_relative_filename;
+			Material.material_textures_names.Add("_MainTex");
+			Material.material_textures.Add(Material.main_texture);
+		}
+		Json.materials.Add(Material);
+		Json.json_info.materials.Add(Material.asset_relative_filename);
+	}
+
+	// Meshes
+	TArray<FString> FbxFiles = ExportDefaultMeshesToFbx(ExportFolder + "/Meshes/Default");
+	for (int x = 0; x < Settings.MeshCount && FbxFiles.Num() > 0; x++) {
+		FUtuPluginMesh Mesh;
+		Mesh.asset_name = FString::Printf(TEXT("SM_Synthetic_%05d"), x);
+		Mesh.asset_relative_filename = UnityFolder + "/Meshes/" + Mesh.asset_name + ".fbx";
+		Mesh.mesh_file_absolute_filename = FbxFiles[x % FbxFiles.Num()];
+		Mesh.mesh_import_position_offset = FVector::ZeroVector;
+		Mesh.mesh_import_rotation_offset = FQuat::Identity;
+		Mesh.mesh_import_scale_offset = FVector(1.0f);
+		Mesh.mesh_import_scale_factor = 1.0f;
+		if (Json.materials.Num() > 0) {
+			Mesh.mesh_materials_relative_filenames.Add(Json.materials[x % Json.materials.Num()].asset_relative_filename);
+		}
+		Json.meshes.Add(Mesh);
+		Json.json_info.meshes.Add(Mesh.asset_relative_filename);
+	}
+
+	// Prefabs
+	for (int x = 0; x < Settings.PrefabCount; x++) {
+		FUtuPluginPrefabFirstPass FirstPass;
+		FirstPass.asset_name = FString::Printf(TEXT("BP_Synthetic_%05d"), x);
+		FirstPass.asset_relative_filename = UnityFolder + "/Prefabs/" + FirstPass.asset_name + ".prefab";
+		FirstPass.has_any_static_child = true;
+		FUtuPluginPrefabSecondPass SecondPass;
+		SecondPass.asset_name = FirstPass.asset_name;
+		SecondPass.asset_relative_filename = FirstPass.asset_relative_filename;
+		for (int y = 0; y < Settings.ComponentsPerPrefab && Json.meshes.Num() > 0; y++) {
+			FUtuPluginActor Component = MakeSyntheticActor(y, FString::Printf(TEXT("Component_%d"), y), FVector(Random.FRandRange(-2.0f, 2.0f), Random.FRandRange(0.0f, 2.0f), Random.FRandRange(-2.0f, 2.0f)));
+			Component.actor_types.Add(EUtuActorType::StaticMesh);
+			const FUtuPluginMesh& Mesh = Json.meshes[Random.RandHelper(Json.meshes.Num())];
+			Component.actor_mesh.actor_mesh_relative_filename = Mesh.asset_relative_filename;
+			Component.actor_mesh.actor_mesh_materials_relative_filenames = Mesh.mesh_materials_relative_filenames;
+			SecondPass.prefab_components.Add(Component);
+		}
+		Json.prefabs_first_pass.Add(FirstPass);
+		Json.prefabs_second_pass.Add(SecondPass);
+		Json.json_info.prefabs.Add(FirstPass.asset_relative_filename);
+	}
+
+	// Scenes
+	for (int x = 0; x < Settings.SceneCount; x++) {
+		FUtuPluginScene Scene;
+		Scene.asset_name = FString::Printf(TEXT("Scene_Synthetic_%05d"), x);
+		Scene.asset_relative_filename = UnityFolder + "/Scenes/" + Scene.asset_name + ".unity";
+		for (int y = 0; y < Settings.ActorsPerScene; y++) {
+			FUtuPluginActor Actor = MakeSyntheticActor(y, FString::Printf(TEXT("Actor_%d"), y), FVector(Random.FRandRange(-500.0f, 500.0f), 0.0f, Random.FRandRange(-500.0f, 500.0f)));
+			bool bPrefab = Json.prefabs_first_pass.Num() > 0 && (Json.meshes.Num() == 0 || Random.FRand() < 0.5f);
+			if (bPrefab) {
+				Actor.actor_types.Add(EUtuActorType::Prefab);
+				Actor.actor_prefab.actor_prefab_relative_filename = Json.prefabs_first_pass[Random.RandHelper(Json.prefabs_first_pass.Num())].asset_relative_filename;
+			}
+			else if (Json.meshes.Num() > 0) {
+				Actor.actor_types.Add(EUtuActorType::StaticMesh);
+				const FUtuPluginMesh& Mesh = Json.meshes[Random.RandHelper(Json.meshes.Num())];
+				Actor.actor_mesh.actor_mesh_relative_filename = Mesh.asset_relative_filename;
+				Actor.actor_mesh.actor_mesh_materials_relative_filenames = Mesh.mesh_materials_relative_filenames;
+			}
+			else {
+				Actor.actor_types.Add(EUtuActorType::Empty);
+			}
+			Scene.scene_actors.Add(Actor);
+		}
+		Json.scenes.Add(Scene);
+		Json.json_info.scenes.Add(Scene.asset_relative_filename);
+	}
+
+	FString JsonString;
+	FJsonObjectConverter::UStructToJsonObjectString(Json, JsonString);
+	FFileHelper::SaveStringToFile(JsonString, *JsonFile);
+	return JsonFile;
+}
+
+TArray<FUtuPluginBenchmarkPhase> UUtuPluginBenchmark::RunImportBenchmark(FString JsonFile) {
+	TArray<FUtuPluginBenchmarkPhase> Ret;
+	FUtuPluginJson Json = UUtuPluginJsonUtilities::ReadExportJsonFromFile(JsonFile);
+	Json.json_info.json_file_fullname = JsonFile;
+	TMap<FString, int> AssetCounts;
+	AssetCounts.Add("Textures", Json.textures.Num());
+	AssetCounts.Add("Materials", Json.materials.Num());
+	AssetCounts.Add("Meshes", Json.meshes.Num());
+	AssetCounts.Add("Animations", Json.animations.Num());
+	AssetCounts.Add("Prefabs: First Pass", Json.prefabs_first_pass.Num());
+	AssetCounts.Add("Prefabs: Second Pass", Json.prefabs_second_pass.Num());
+	AssetCounts.Add("Scenes", Json.scenes.Num());
+
+	// One asset per step, like the editor tick, so the time and memory can be split per phase
+	FUtuPluginCurrentImport Job;
+	Job.bIsValid = true;
+	Job.BeginImport(Json, { EUtuAssetType::Texture, EUtuAssetType::Material, EUtuAssetType::Mesh, EUtuAssetType::Animation, EUtuAssetType::PrefabFirstPass, EUtuAssetType::PrefabSecondPass, EUtuAssetType::Scene });
+	bool bCompleted = false;
+	while (!bCompleted) {
+		uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+		double StartTime = FPlatformTime::Seconds();
+		bCompleted = Job.ContinueImport(false);
+		double Seconds = FPlatformTime::Seconds() - StartTime;
+		FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+		if (Ret.Num() == 0 || Ret.Last().Phase != Job.nameUtuAssetTypesToProcess) {
+			FUtuPluginBenchmarkPhase Phase;
+			Phase.Phase = Job.nameUtuAssetTypesToProcess;
+			Phase.AssetCount = AssetCounts.FindRef(Job.nameUtuAssetTypesToProcess);
+			Ret.Add(Phase);
+		}
+		FUtuPluginBenchmarkPhase& Phase = Ret.Last();
+		Phase.Seconds += Seconds;
+		Phase.UsedMemoryDeltaMB += ((int64)MemoryStats.UsedPhysical - (int64)UsedBefore) / (1024.0f * 1024.0f);
+		Phase.PeakUsedMemoryMB = FMath::Max(Phase.PeakUsedMemoryMB, MemoryStats.UsedPhysical / (1024.0f * 1024.0f));
+	}
+	for (FUtuPluginBenchmarkPhase& Phase : Ret) {
+		Phase.AssetsPerSecond = Phase.AssetCount / FMath::Max(Phase.Seconds, 0.001f);
+	}
+
+	// Csv
+	FString CsvFile = FPaths::GetPath(JsonFile) + UtuPluginPaths::slash + "UnrealBenchmark.csv";
+	FString Csv = "";
+	if (!FPaths::FileExists(CsvFile)) {
+		Csv += "Time,UtuVersion,UnrealVersion,Phase,AssetCount,Seconds,AssetsPerSecond,PeakUsedMemoryMB,UsedMemoryDeltaMB\n";
+	}
+	FString Time = FDateTime::UtcNow().ToString();
+	FString UnrealVersion = FString::FromInt(ENGINE_MAJOR_VERSION) + "." + FString::FromInt(ENGINE_MINOR_VERSION);
+	FString UtuVersion = UUtuPlugin::GetUtuPluginVersion().TrimStartAndEnd();
+	for (const FUtuPluginBenchmarkPhase& Phase : Ret) {
+		Csv += FString::Printf(TEXT("%s,%s,%s,%s,%d,%.3f,%.3f,%.1f,%.1f\n"), *Time, *UtuVersion, *UnrealVersion, *Phase.Phase, Phase.AssetCount, Phase.Seconds, Phase.AssetsPerSecond, Phase.PeakUsedMemoryMB, Phase.UsedMemoryDeltaMB);
+	}
+	FFileHelper::SaveStringToFile(Csv, *CsvFile, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	return Ret;
+}
+
+TArray<FString> UUtuPluginBenchmark::ExportDefaultMeshesToFbx(FString InFolder) {
+	TArray<FString> Ret;
+	for (FString MeshName : { "Cube", "Sphere", "Capsule", "Cylinder", "Plane", "Quad" }) {
+		FString FbxPath = InFolder + UtuPluginPaths::slash + MeshName + ".fbx";
+		if (!FPaths::FileExists(FbxPath)) {
+			UStaticMesh* Mesh = Cast<UStaticMesh>(UUtuPluginLibrary::TryGetAsset("/UtuPlugin/Default/" + MeshName));
+			UExporter* Exporter = Mesh != nullptr ? UExporter::FindExporter(Mesh, TEXT("fbx")) : nullptr;
+			if (Exporter == nullptr) {
+				continue;
+			}
+			Exporter->SetBatchMode(true);
+			Exporter->SetCancelBatch(false);
+			Exporter->SetShowExportOption(false);
+			FGCObjectScopeGuard ExporterGuard(Exporter);
+
+			UAssetExportTask* ExportTask = NewObject<UAssetExportTask>();
+			FGCObjectScopeGuard ExportTaskGuard(ExportTask);
+			ExportTask->Object = Mesh;
+			ExportTask->Exporter = Exporter;
+			ExportTask->Filename = FbxPath;
+			ExportTask->bSelected = false;
+			ExportTask->bReplaceIdentical = true;
+			ExportTask->bPrompt = false;
+			ExportTask->bWriteEmptyFiles = false;
+			ExportTask->bAutomated = true;
+			UFbxExportOption* Options = NewObject<UFbxExportOption>();
+			Options->bASCII = false;
+			Options->LevelOfDetail = false;
+			Options->Collision = false;
+			ExportTask->Options = Options;
+
+			IFileManager::Get().MakeDirectory(*InFolder, true);
+			UExporter::RunAssetExportTask(ExportTask);
+		}
+		if (FPaths::FileExists(FbxPath)) {
+			Ret.Add(FbxPath);
+		}
+	}
+	return Ret;
+}
+
+bool UUtuPluginBenchmark::WriteSyntheticTexture(FString InFilename, int InSize, int InIndex, int InSeed) {
+	InSize = FMath::Max(InSize, 4);
+	FRandomStream Random(InSeed * 7919 + InIndex);
+	FColor ColorA(Random.RandRange(0, 255), Random.RandRange(0, 255), Random.RandRange(0, 255), 255);
+	FColor ColorB(Random.RandRange(0, 255), Random.RandRange(0, 255), Random.RandRange(0, 255), 255);
+	int CheckerSize = FMath::Max(InSize / (2 + InIndex % 8), 1);
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(InSize * InSize);
+	for (int y = 0; y < InSize; y++) {
+		for (int x = 0; x < InSize; x++) {
+			Pixels[y * InSize + x] = ((x / CheckerSize) + (y / CheckerSize)) % 2 == 0 ? ColorA : ColorB;
+		}
+	}
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), InSize, InSize, ERGBFormat::BGRA, 8)) {
+		return false;
+	}
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilename), true);
+	return FFileHelper::SaveArrayToFile(ImageWrapper->GetCompressed(), *InFilename);
+}
+
+FUtuPluginActor UUtuPluginBenchmark::MakeSyntheticActor(int InId, FString InName, FVector InLocation) {
+	FUtuPluginActor Actor;
+	Actor.actor_id = InId;
+	Actor.actor_parent_id = UtuConst::INVALID_INT;
+	Actor.actor_display_name = InName;
+	Actor.actor_is_visible = true;
+	Actor.actor_world_location = InLocation;
+	Actor.actor_world_rotation = FQuat::Identity;
+	Actor.actor_world_scale = FVector(1.0f);
+	Actor.actor_relative_location = InLocation;
+	Actor.actor_relative_rotation = FQuat::Identity;
+	Actor.actor_relative_scale = FVector(1.0f);
+	Actor.actor_is_movable = false;
+	return Actor;
+}
+
+UUtuPluginBenchmarkCommandlet::UUtuPluginBenchmarkCommandlet() {
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UUtuPluginBenchmarkCommandlet::Main(const FString& Params) {
+	FString JsonFile = "";
+	if (!FParse::Value(*Params, TEXT("Json="), JsonFile)) {
+		FUtuPluginSyntheticExportSettings Settings;
+		FParse::Value(*Params, TEXT("Name="), Settings.ExportName);
+		FParse::Value(*Params, TEXT("Scenes="), Settings.SceneCount);
+		FParse::Value(*Params, TEXT("Actors="), Settings.ActorsPerScene);
+		FParse::Value(*Params, TEXT("Prefabs="), Settings.PrefabCount);
+		FParse::Value(*Params, TEXT("Components="), Settings.ComponentsPerPrefab);
+		FParse::Value(*Params, TEXT("Meshes="), Settings.MeshCount);
+		FParse::Value(*Params, TEXT("Materials="), Settings.MaterialCount);
+		FParse::Value(*Params, TEXT("Textures="), Settings.TextureCount);
+		FParse::Value(*Params, TEXT("TextureSize="), Settings.TextureSize);
+		FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+		JsonFile = UUtuPluginBenchmark::GenerateSyntheticExport(Settings);
+		UE_LOG(UTU, Display, TEXT("Synthetic export generated: %s"), *JsonFile);
+	}
+	if (!FPaths::FileExists(JsonFile)) {
+		UE_LOG(UTU, Error, TEXT("Export json not found: %s"), *JsonFile);
+		return 1;
+	}
+
+	// No prompt in a headless run
+	FUtuPluginImportSettings ImportSettings = UUtuPlugin::currentImportSettings;
+	ImportSettings.SavingBehavior = EUtuSavingBehavior::SaveAllAtEnd;
+	UUtuPlugin::SetImportSettings(ImportSettings);
+
+	TArray<FUtuPluginBenchmarkPhase> Phases = UUtuPluginBenchmark::RunImportBenchmark(JsonFile);
+	UE_LOG(UTU, Display, TEXT("%-24s %8s %10s %10s %12s"), TEXT("Phase"), TEXT("Assets"), TEXT("Seconds"), TEXT("Assets/s"), TEXT("Peak MB"));
+	for (const FUtuPluginBenchmarkPhase& Phase : Phases) {
+		UE_LOG(UTU, Display, TEXT("%-24s %8d %10.3f %10.3f %12.1f"), *Phase.Phase, Phase.AssetCount, Phase.Seconds, Phase.AssetsPerSecond, Phase.PeakUsedMemoryMB);
+	}
+	UE_LOG(UTU, Display, TEXT("Results appended to: %s"), *(FPaths::GetPath(JsonFile) + UtuPluginPaths::slash + "UnrealBenchmark.csv"));
+	return 0;
+}
@@ -0,0 +1,203 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginCostModel.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
+#include "Runtime/Core/Public/Misc/FileHelper.h"
+#include "Runtime/Json/Public/Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static const double UtuCostModelMaxSamples = 500.0; // Older samples fade out so the model follows the machine and engine changes
+
+bool UtuPluginCostModel::bIsLoaded = false;
+FUtuPluginCostFit UtuPluginCostModel::Fits[(int32)EUtuAssetType::PrefabSecondPass + 1];
+double UtuPluginCostModel::TotalEstimatedSeconds = 0.0;
+double UtuPluginCostModel::DoneEstimatedSeconds = 0.0;
+
+void FUtuPluginCostFit::AddSample(double Units, double Seconds) {
+	if (Count >= UtuCostModelMaxSamples) {
+		double Decay = (UtuCostModelMaxSamples - 1.0) / Count;
+		Count *= Decay;
+		SumUnits *= Decay;
+		SumSeconds *= Decay;
+		SumUnitsSquared *= Decay;
+		SumUnitsSeconds *= Decay;
+	}
+	Count += 1.0;
+	SumUnits += Units;
+	SumSeconds += Seconds;
+	SumUnitsSquared += Units * Units;
+	SumUnitsSeconds += Units * Seconds;
+}
+
+double FUtuPluginCostFit::Estimate(double Units) const {
+	if (Count < 2.0) {
+		return DefaultBase + DefaultPerUnit * Units;
+	}
+	double Base = SumSeconds / Count;
+	double PerUnit = 0.0;
+	double Denominator = Count * SumUnitsSquared - SumUnits * SumUnits;
+	if (Denominator > KINDA_SMALL_NUMBER) {
+		PerUnit = FMath::Max((Count * SumUnitsSeconds - SumUnits * SumSeconds) / Denominator, 0.0);
+		Base = FMath::Max((SumSeconds - PerUnit * SumUnits) / Count, 0.0);
+	}
+	return Base + PerUnit * Units;
+}
+
+int64 UtuPluginCostModel::GetAssetSourceBytes(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index) {
+	FString Filename = "";
+	switch (AssetType) {
+	case EUtuAssetType::Mesh:
+		Filename = Json.meshes[Index].mesh_file_absolute_filename;
+		break;
+	case EUtuAssetType::Animation:
+		Filename = Json.animations[Index].animation_file_absolute_filename;
+		break;
+	case EUtuAssetType::Texture:
+		Filename = Json.textures[Index].texture_file_absolute_filename;
+		break;
+	default:
+		return 0;
+	}
+	return FMath::Max(IFileManager::Get().FileSize(*Filename), (int64)0);
+}
+
+double UtuPluginCostModel::GetAssetUnits(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index) {
+	switch (AssetType) {
+	case EUtuAssetType::Scene:
+		return Json.scenes[Index].scene_actors.Num();
+	case EUtuAssetType::Mesh:
+	case EUtuAssetType::Animation:
+	case EUtuAssetType::Texture:
+		return GetAssetSourceBytes(Json, AssetType, Index) / (1024.0 * 1024.0);
+	case EUtuAssetType::Material:
+	{
+		const FUtuPluginMaterial& Material = Json.materials[Index];
+		return Material.material_floats.Num() + Material.material_ints.Num() + Material.material_textures.Num() + Material.material_colors.Num() + Material.material_vectors.Num() + Material.material_vector2s.Num();
+	}
+	case EUtuAssetType::PrefabSecondPass:
+		return Json.prefabs_second_pass[Index].prefab_components.Num();
+	default:
+		break;
+	}
+	return 0.0;
+}
+
+double UtuPluginCostModel::EstimateSeconds(EUtuAssetType AssetType, double Units) {
+	if (!bIsLoaded) {
+		Load();
+	}
+	return Fits[(int32)AssetType].Estimate(Units);
+}
+
+void UtuPluginCostModel::BeginImport(const FUtuPluginJson& Json, TArray<EUtuAssetType> AssetTypes) {
+	if (!bIsLoaded) {
+		Load();
+	}
+	TotalEstimatedSeconds = 0.0;
+	DoneEstimatedSeconds = 0.0;
+	for (EUtuAssetType AssetType : AssetTypes) {
+		int Num = 0;
+		switch (AssetType) {
+		case EUtuAssetType::Scene: Num = Json.scenes.Num(); break;
+		case EUtuAssetType::Mesh: Num = Json.meshes.Num(); break;
+		case EUtuAssetType::Animation: Num = Json.animations.Num(); break;
+		case EUtuAssetType::Material: Num = Json.materials.Num(); break;
+		case EUtuAssetType::Texture: Num = Json.textures.Num(); break;
+		case EUtuAssetType::PrefabFirstPass: Num = Json.prefabs_first_pass.Num(); break;
+		case EUtuAssetType::PrefabSecondPass: Num = Json.prefabs_second_pass.Num(); break;
+		default: break;
+		}
+		for (int x = 0; x < Num; x++) {
+			TotalEstimatedSeconds += EstimateSeconds(AssetType, GetAssetUnits(Json, AssetType, x));
+		}
+	}
+	UTU_LOG_L("    Estimated Import Time: " + FString::Printf(TEXT("%.0f"), TotalEstimatedSeconds) + " seconds");
+}
+
+void UtuPluginCostModel::CompleteAsset(EUtuAssetType AssetType, double Units, double Seconds) {
+	DoneEstimatedSeconds += EstimateSeconds(AssetType, Units); // Before the sample, to stay consistent with the total
+	Fits[(int32)AssetType].AddSample(Units, Seconds);
+}
+
+void UtuPluginCostModel::CompleteImport() {
+	Save();
+}
+
+float UtuPluginCostModel::GetWeightedProgress() {
+	return TotalEstimatedSeconds > 0.0 ? FMath::Clamp(DoneEstimatedSeconds / TotalEstimatedSeconds, 0.0, 1.0) : 0.0f;
+}
+
+float UtuPluginCostModel::GetEtaSeconds(double ElapsedSeconds) {
+	if (DoneEstimatedSeconds <= 0.0) {
+		return -1.0f;
+	}
+	// The estimates come from other imports, scale them by how fast this one is going
+	double Speed = ElapsedSeconds / DoneEstimatedSeconds;
+	return FMath::Max(TotalEstimatedSeconds - DoneEstimatedSeconds, 0.0) * Speed;
+}
+
+FString UtuPluginCostModel::GetCostModelFilename() {
+	return FPaths::ProjectSavedDir() / "UtuPlugin" / "CostModel.json";
+}
+
+void UtuPluginCostModel::Load() {
+	bIsLoaded = true;
+	// Defaults: rough timings of an average editor machine, replaced as soon as the project has its own samples
+	Fits[(int32)EUtuAssetType::Texture].DefaultBase = 0.05;
+	Fits[(int32)EUtuAssetType::Texture].DefaultPerUnit = 0.15;
+	Fits[(int32)EUtuAssetType::Material].DefaultBase = 0.05;
+	Fits[(int32)EUtuAssetType::Material].DefaultPerUnit = 0.01;
+	Fits[(int32)EUtuAssetType::Mesh].DefaultBase = 0.2;
+	Fits[(int32)EUtuAssetType::Mesh].DefaultPerUnit = 0.5;
+	Fits[(int32)EUtuAssetType::Animation].DefaultBase = 0.1;
+	Fits[(int32)EUtuAssetType::Animation].DefaultPerUnit = 0.3;
+	Fits[(int32)EUtuAssetType::PrefabFirstPass].DefaultBase = 0.1;
+	Fits[(int32)EUtuAssetType::PrefabSecondPass].DefaultBase = 0.05;
+	Fits[(int32)EUtuAssetType::PrefabSecondPass].DefaultPerUnit = 0.02;
+	Fits[(int32)EUtuAssetType::Scene].DefaultBase = 0.5;
+	Fits[(int32)EUtuAssetType::Scene].DefaultPerUnit = 0.01;
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetCostModelFilename())) {
+		return;
+	}
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid()) {
+		return;
+	}
+	UEnum* AssetTypeEnum = StaticEnum<EUtuAssetType>();
+	for (int32 Type = 0; Type <= (int32)EUtuAssetType::PrefabSecondPass; Type++) {
+		const TSharedPtr<FJsonObject>* Fit;
+		if (JsonObject->TryGetObjectField(AssetTypeEnum->GetNameStringByValue(Type), Fit)) {
+			Fits[Type].Count = (*Fit)->GetNumberField(TEXT("count"));
+			Fits[Type].SumUnits = (*Fit)->GetNumberField(TEXT("sum_units"));
+			Fits[Type].SumSeconds = (*Fit)->GetNumberField(TEXT("sum_seconds"));
+			Fits[Type].SumUnitsSquared = (*Fit)->GetNumberField(TEXT("sum_units_squared"));
+			Fits[Type].SumUnitsSeconds = (*Fit)->GetNumberField(TEXT("sum_units_seconds"));
+		}
+	}
+}
+
+void UtuPluginCostModel::Save() {
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	UEnum* AssetTypeEnum = StaticEnum<EUtuAssetType>();
+	for (int32 Type = 0; Type <= (int32)EUtuAssetType::PrefabSecondPass; Type++) {
+		TSharedRef<FJsonObject> Fit = MakeShared<FJsonObject>();
+		Fit->SetNumberField(TEXT("count"), Fits[Type].Count);
+		Fit->SetNumberField(TEXT("sum_units"), Fits[Type].SumUnits);
+		Fit->SetNumberField(TEXT("sum_seconds"), Fits[Type].SumSeconds);
+		Fit->SetNumberField(TEXT("sum_units_squared"), Fits[Type].SumUnitsSquared);
+		Fit->SetNumberField(TEXT("sum_units_seconds"), Fits[Type].SumUnitsSeconds);
+		JsonObject->SetObjectField(AssetTypeEnum->GetNameStringByValue(Type), Fit);
+	}
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	if (FJsonSerializer::Serialize(JsonObject, JsonWriter)) {
+		FFileHelper::SaveStringToFile(JsonString, *GetCostModelFilename());
+	}
+}
@@ -0,0 +1,89 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginImportEvents.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginCostModel.h"
+#include "Editor.h"
+
+FUtuPluginImportProgress UUtuPluginImportEvents::GetProgressSnapshot() const {
+	FUtuPluginImportProgress Snapshot = Progress;
+	if (Snapshot.bIsImporting) {
+		Snapshot.ElapsedSeconds = FPlatformTime::Seconds() - ImportStartTime;
+	}
+	return Snapshot;
+}
+
+UUtuPluginImportEvents* UUtuPluginImportEvents::Get() {
+	return GEditor != nullptr ? GEditor->GetEditorSubsystem<UUtuPluginImportEvents>() : nullptr;
+}
+
+void UUtuPluginImportEvents::UpdateTimeAndLog() {
+	Progress.ElapsedSeconds = FPlatformTime::Seconds() - ImportStartTime;
+	Progress.Percent = (float)Progress.AssetsProcessed / (float)FMath::Max(Progress.AssetCount, 1);
+	Progress.PhasePercent = (float)Progress.PhaseAssetsProcessed / (float)FMath::Max(Progress.PhaseAssetCount, 1);
+	Progress.WeightedPercent = UtuPluginCostModel::GetWeightedProgress();
+	Progress.EtaSeconds = UtuPluginCostModel::GetEtaSeconds(Progress.ElapsedSeconds);
+	EUtuLog LogState;
+	UUtuPluginLog::GetLogState(LogState, Progress.WarningCount, Progress.ErrorCount);
+}
+
+void UUtuPluginImportEvents::NotifyImportStarted(int PhaseCount, int AssetCount) {
+	UUtuPluginImportEvents* Events = Get();
+	if (Events == nullptr) {
+		return;
+	}
+	Events->Progress = FUtuPluginImportProgress();
+	Events->Progress.bIsImporting = true;
+	Events->Progress.PhaseCount = PhaseCount;
+	Events->Progress.AssetCount = AssetCount;
+	Events->ImportStartTime = FPlatformTime::Seconds();
+	Events->OnImportStarted.Broadcast(Events->Progress);
+}
+
+void UUtuPluginImportEvents::NotifyPhaseStarted(FString Phase, int PhaseAssetCount) {
+	UUtuPluginImportEvents* Events = Get();
+	if (Events == nullptr) {
+		return;
+	}
+	Events->Progress.Phase = Phase;
+	Events->Progress.PhaseIndex++;
+	Events->Progress.PhaseAssetCount = PhaseAssetCount;
+	Events->Progress.PhaseAssetsProcessed = 0;
+	Events->UpdateTimeAndLog();
+	Events->OnPhaseStarted.Broadcast(Events->Progress);
+}
+
+void UUtuPluginImportEvents::NotifyPhaseCompleted() {
+	UUtuPluginImportEvents* Events = Get();
+	if (Events == nullptr) {
+		return;
+	}
+	Events->UpdateTimeAndLog();
+	Events->OnPhaseCompleted.Broadcast(Events->Progress);
+}
+
+void UUtuPluginImportEvents::NotifyAssetCompleted(const FUtuPluginAssetEvent& Event, double Seconds) {
+	UUtuPluginImportEvents* Events = Get();
+	if (Events == nullptr || !Events->Progress.bIsImporting) {
+		return;
+	}
+	Events->Progress.LastAsset = Event.UnrealPath;
+	Events->Progress.PhaseAssetsProcessed++;
+	Events->Progress.AssetsProcessed++;
+	Events->UpdateTimeAndLog();
+	Events->OnAssetCompleted.Broadcast(Events->Progress, Event.UnrealPath, Event.GetOutcome(), Seconds);
+}
+
+void UUtuPluginImportEvents::NotifyImportCompleted(bool bWasCancelled) {
+	UUtuPluginImportEvents* Events = Get();
+	if (Events == nullptr || !Events->Progress.bIsImporting) {
+		return;
+	}
+	Events->UpdateTimeAndLog();
+	Events->Progress.bIsImporting = false;
+	Events->Progress.bWasCancelled = bWasCancelled;
+	if (!bWasCancelled) {
+		Events->Progress.EtaSeconds = 0.0f;
+	}
+	Events->OnImportCompleted.Broadcast(Events->Progress);
+}
@@ -176,6 +176,8 @@ bool UUtuPluginLibrary::DoesAssetExists(FString InAssetRelativeFilename) {
 }
 
 UObject* UUtuPluginLibrary::TryGetAsset(FString InAssetRelativeFilename) {
+	UTU_TRACE_SCOPE("UtuPlugin::TryGetAsset");
+	FUtuPluginEventStageTimer StageTimer(EUtuEventStage::Lookup);
 	return StaticLoadObject(UObject::StaticClass(), nullptr, *InAssetRelativeFilename, (const TCHAR*)nullptr, LOAD_NoWarn);
 	//if (DoesAssetExists(InAssetRelativeFilename)) {
 	//	return StaticLoadObject(UObject::StaticClass(), nullptr, *InAssetRelativeFilename);
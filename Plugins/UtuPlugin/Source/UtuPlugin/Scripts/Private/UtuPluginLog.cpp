@@ -2,19 +2,32 @@
 
 #include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
 #include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginReport.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginImportEvents.h"
 #include "Runtime/Core/Public/Misc/FileHelper.h"
 #include "HAL/PlatformFilemanager.h" 
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/CoreDelegates.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 
 DEFINE_LOG_CATEGORY(UTU);
 
 TArray<FUtuLog> UUtuPluginLog::Log;
+int UUtuPluginLog::LogTotal;
 FString UUtuPluginLog::LogString;
+int UUtuPluginLog::LogStringStart;
+FString UUtuPluginLog::LogContext;
+int UUtuPluginLog::LogCount;
 int UUtuPluginLog::ErrorCount;
 int UUtuPluginLog::WarningCount;
 EUtuLog UUtuPluginLog::LogState;
 FString UUtuPluginLog::Timestamp;
 StringOutputDevice* UUtuPluginLog::OutputDevice = nullptr;
 FString UUtuPluginLog::LogFilePath;
+TUniquePtr<FUtuPluginLogWriter> UUtuPluginLog::LogWriter;
+FUtuPluginAssetEvent UUtuPluginLog::CurrentEvent;
 
 void UUtuPluginLog::InitializeNewLog(FString JsonFilePath, FString InTimestamp) {
 	UUtuPluginLog::Timestamp = InTimestamp;
@@ -28,35 +41,142 @@ void UUtuPluginLog::InitializeNewLog(FString JsonFilePath, FString InTimestamp)
 		FPlatformFileManager::Get().GetPlatformFile().MoveFile(*(UUtuPluginLog::LogFilePath.Replace(TEXT(".log"), *("_Backup_" + BackupTimestamp + ".log"))), *UUtuPluginLog::LogFilePath);
 	}
 	// Redirect log
+	if (OutputDevice != nullptr && OutputDevice->bIsRegistered)
+	{
+		OutputDevice->UnregisterFromLog();
+		OutputDevice->FlushChunk();
+	}
+	FString UnrealPath = UUtuPluginLog::LogFilePath.Replace(TEXT("UnrealImport.log"), TEXT("UnrealLog.log"));
+	FString EventsPath = UUtuPluginLog::LogFilePath.Replace(TEXT("UnrealImport.log"), TEXT("UnrealImportEvents.jsonl"));
+	LogWriter.Reset(); // Flushes the previous import
+	LogWriter = MakeUnique<FUtuPluginLogWriter>(UUtuPluginLog::LogFilePath, UnrealPath, EventsPath);
+	CurrentEvent = FUtuPluginAssetEvent();
 	if (OutputDevice != nullptr)
 	{
-		if (OutputDevice->bIsRegistered)
-		{
-			OutputDevice->UnregisterFromLog();
-		}
 		OutputDevice->RegisterToLog();
 	}
+	// Crash
+	static bool bCrashHandlerRegistered = false;
+	if (!bCrashHandlerRegistered) {
+		bCrashHandlerRegistered = true;
+		FCoreDelegates::OnHandleSystemError.AddLambda([]() {
+			if (OutputDevice != nullptr) {
+				OutputDevice->FlushChunk(true);
+			}
+			if (LogWriter.IsValid()) {
+				LogWriter->Flush(true);
+			}
+		});
+	}
 }
 
 void UUtuPluginLog::PrintIntoLogFile(FString Message, bool bForceWrite) {
-	static FString Messages = "";
-	static int MessageCount = 0;
-	Messages += Message + "\n";
-	MessageCount++;
-	if (bForceWrite || MessageCount >= 1000) {
-		FString FileContent = "";
-		FFileHelper::LoadFileToString(FileContent, *UUtuPluginLog::LogFilePath);
-		FFileHelper::SaveStringToFile(FileContent + Messages, *UUtuPluginLog::LogFilePath);
-		MessageCount = 0;
-		Messages = "";
-		if (OutputDevice != nullptr)
-		{
-			FString UnrealPath = UUtuPluginLog::LogFilePath.Replace(TEXT("UnrealImport.log"), TEXT("UnrealLog.log"));
-			FFileHelper::SaveStringToFile(OutputDevice->MyLog, *UnrealPath);
+	if (LogWriter.IsValid()) {
+		LogWriter->Write(EUtuLogFile::Import, Message + "\n");
+		if (bForceWrite) {
+			if (OutputDevice != nullptr) {
+				OutputDevice->FlushChunk();
+			}
+			LogWriter->Flush();
 		}
 	}
 }
 
+void UUtuPluginLog::PrintIntoUnrealLogFile(FString Message) {
+	if (LogWriter.IsValid()) {
+		LogWriter->Write(EUtuLogFile::Unreal, Message);
+	}
+}
+
+void UUtuPluginLog::FlushLogFiles() {
+	if (OutputDevice != nullptr) {
+		OutputDevice->FlushChunk();
+	}
+	if (LogWriter.IsValid()) {
+		LogWriter->Flush();
+	}
+}
+
+void UUtuPluginLog::BeginAssetEvent(FString AssetType, FString UnityPath, FString UnrealPath) {
+	EndAssetEvent();
+	CurrentEvent.bActive = true;
+	CurrentEvent.AssetType = AssetType;
+	CurrentEvent.UnityPath = UnityPath;
+	CurrentEvent.UnrealPath = UnrealPath;
+	CurrentEvent.StartTime = FPlatformTime::Seconds();
+}
+
+void UUtuPluginLog::SetAssetEventOutcome(FString Outcome) {
+	CurrentEvent.Outcome = Outcome;
+}
+
+void UUtuPluginLog::AddEventStageTime(EUtuEventStage Stage, double Seconds) {
+	if (CurrentEvent.bActive) {
+		CurrentEvent.StageTimes[(int32)Stage] += Seconds;
+	}
+}
+
+void UUtuPluginLog::EndAssetEvent() {
+	if (!CurrentEvent.bActive) {
+		return;
+	}
+	static const TCHAR* StageNames[] = { TEXT("lookup"), TEXT("import"), TEXT("post_edit") }; // Saving is batched, see AddSaveEvent
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("event"), TEXT("asset"));
+	Writer->WriteValue(TEXT("asset_type"), CurrentEvent.AssetType);
+	Writer->WriteValue(TEXT("unity_path"), CurrentEvent.UnityPath);
+	Writer->WriteValue(TEXT("unreal_path"), CurrentEvent.UnrealPath);
+	Writer->WriteValue(TEXT("outcome"), CurrentEvent.GetOutcome());
+	Writer->WriteValue(TEXT("warning_count"), CurrentEvent.WarningCount);
+	Writer->WriteValue(TEXT("error_count"), CurrentEvent.ErrorCount);
+	Writer->WriteArrayStart(TEXT("messages"));
+	for (const FString& Message : CurrentEvent.Messages) {
+		Writer->WriteValue(Message);
+	}
+	Writer->WriteArrayEnd();
+	double TotalSeconds = FPlatformTime::Seconds() - CurrentEvent.StartTime;
+	Writer->WriteObjectStart(TEXT("seconds"));
+	Writer->WriteValue(TEXT("total"), TotalSeconds);
+	for (int32 Stage = 0; Stage < (int32)EUtuEventStage::Count; Stage++) {
+		Writer->WriteValue(StageNames[Stage], CurrentEvent.StageTimes[Stage]);
+	}
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	UtuPluginReport::AddAsset(CurrentEvent, TotalSeconds);
+	UUtuPluginImportEvents::NotifyAssetCompleted(CurrentEvent, TotalSeconds);
+	CurrentEvent = FUtuPluginAssetEvent();
+	if (LogWriter.IsValid()) {
+		LogWriter->Write(EUtuLogFile::Events, Line + "\n");
+	}
+}
+
+void UUtuPluginLog::AddSaveEvent(int PackageCount, double Seconds) {
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("event"), TEXT("save"));
+	Writer->WriteValue(TEXT("package_count"), PackageCount);
+	Writer->WriteValue(TEXT("seconds"), Seconds);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	UtuPluginReport::AddSave(Seconds);
+	if (LogWriter.IsValid()) {
+		LogWriter->Write(EUtuLogFile::Events, Line + "\n");
+	}
+}
+
+void UUtuPluginLog::ShutdownLogWriter() {
+	if (OutputDevice != nullptr && OutputDevice->bIsRegistered)
+	{
+		OutputDevice->UnregisterFromLog();
+		OutputDevice->FlushChunk();
+	}
+	LogWriter.Reset();
+}
+
 void UUtuPluginLog::OpenDirectoryInWindowsExplorer(FString InPath) {
 	FPlatformProcess::ExploreFolder(*InPath);
 }
@@ -81,12 +201,52 @@ UUtuPluginLog::~UUtuPluginLog()
 	}
 }
 
+const FUtuLog& UUtuPluginLog::GetLogAt(int OrderIndex) {
+	int Oldest = LogTotal > Log.Num() ? LogTotal % Log.Num() : 0;
+	return Log[(Oldest + OrderIndex) % Log.Num()];
+}
+
 TArray<FUtuLog> UUtuPluginLog::GetLog() {
-	return Log;
+	// Two contiguous ranges, the oldest messages are after the write position once the buffer wrapped
+	int Oldest = LogTotal > Log.Num() && Log.Num() > 0 ? LogTotal % Log.Num() : 0;
+	TArray<FUtuLog> Ret;
+	Ret.Reserve(Log.Num());
+	Ret.Append(Log.GetData() + Oldest, Log.Num() - Oldest);
+	Ret.Append(Log.GetData(), Oldest);
+	return Ret;
 }
 
 FString UUtuPluginLog::GetLogString() {
-	return LogString;
+	return LogStringStart == 0 ? LogString : LogString.Mid(LogStringStart);
+}
+
+TArray<FUtuLog> UUtuPluginLog::GetLogPage(int PageIndex, int PageSize, bool bIncludeLogs, bool bIncludeWarnings, bool bIncludeErrors, FString AssetFilter, int& OutMatchingCount) {
+	TArray<FUtuLog> Ret;
+	OutMatchingCount = 0;
+	int FirstMatch = FMath::Max(PageIndex, 0) * FMath::Max(PageSize, 0);
+	for (int x = 0; x < Log.Num(); x++) {
+		const FUtuLog& Entry = GetLogAt(x);
+		bool bCategoryMatch = (Entry.LogCategory == EUtuLog::Log && bIncludeLogs) || (Entry.LogCategory == EUtuLog::Warning && bIncludeWarnings) || (Entry.LogCategory == EUtuLog::Error && bIncludeErrors);
+		if (!bCategoryMatch || (AssetFilter != "" && !Entry.Asset.Contains(AssetFilter))) {
+			continue;
+		}
+		if (OutMatchingCount >= FirstMatch && Ret.Num() < PageSize) {
+			Ret.Add(Entry);
+		}
+		OutMatchingCount++;
+	}
+	return Ret;
+}
+
+void UUtuPluginLog::GetLogCounters(int& OutLogCount, int& OutWarningCount, int& OutErrorCount, int& OutDroppedCount) {
+	OutLogCount = LogCount;
+	OutWarningCount = WarningCount;
+	OutErrorCount = ErrorCount;
+	OutDroppedCount = LogTotal - Log.Num();
+}
+
+void UUtuPluginLog::SetLogContext(FString Asset) {
+	LogContext = Asset;
 }
 
 void UUtuPluginLog::GetLogState(EUtuLog& OutLogState, int& OutWarningCount, int& OutErrorCount) {
@@ -97,6 +257,11 @@ void UUtuPluginLog::GetLogState(EUtuLog& OutLogState, int& OutWarningCount, int&
 
 void UUtuPluginLog::ClearLog() {
 	Log.Empty();
+	LogTotal = 0;
+	LogString.Empty();
+	LogStringStart = 0;
+	LogContext = "";
+	LogCount = 0;
 	ErrorCount = 0;
 	WarningCount = 0;
 	LogState = EUtuLog::Log;
@@ -107,35 +272,69 @@ void UUtuPluginLog::AddToLog(FString Message, EUtuLog LogCategory) {
 	switch (LogCategory) {
 	default:
 	case EUtuLog::Log:
-		LogString += ("\nL    " + Message);
+		LogCount++;
 		PrintIntoLogFile("L    " + Message, false);
 		UE_LOG(UTU, Log, TEXT("%s"), *Message);
 		break;
 	case EUtuLog::Warning:
 		WarningCount++;
+		if (CurrentEvent.bActive) {
+			CurrentEvent.WarningCount++;
+			if (CurrentEvent.Messages.Num() < 20) {
+				CurrentEvent.Messages.Add(Message.TrimStart());
+			}
+		}
 		if (LogState == EUtuLog::Log) {
 			LogState = EUtuLog::Warning;
 		}
-		LogString += ("\nW    " + Message);
 		PrintIntoLogFile("W    " + Message, false);
 		UE_LOG(UTU, Warning, TEXT("%s"), *Message);
 		break;
 	case EUtuLog::Error:
 		ErrorCount++;
+		if (CurrentEvent.bActive) {
+			CurrentEvent.ErrorCount++;
+			if (CurrentEvent.Messages.Num() < 20) {
+				CurrentEvent.Messages.Add(Message.TrimStart());
+			}
+		}
 		LogState = EUtuLog::Error;
-		LogString += ("\nE    " + Message);
 		PrintIntoLogFile("E    " + Message, false);
 		UE_LOG(UTU, Error, TEXT("%s"), *Message);
 		break;
 	}
+	LogString += (LogCategory == EUtuLog::Error ? "\nE    " : LogCategory == EUtuLog::Warning ? "\nW    " : "\nL    ") + Message;
 	NewLog.Message = Message;
 	NewLog.LogCategory = LogCategory;
-	Log.Add(NewLog);
+	NewLog.Index = LogTotal;
+	NewLog.Asset = LogContext;
+	if (Log.Num() < LogCapacity) {
+		Log.Add(MoveTemp(NewLog));
+	}
+	else {
+		// Skip the dropped message in the joined string, compacted once it's mostly dropped messages
+		LogStringStart += 6 + Log[LogTotal % LogCapacity].Message.Len(); // "\nL    " + Message
+		if (LogStringStart > LogString.Len() / 2) {
+			LogString.RemoveAt(0, LogStringStart);
+			LogStringStart = 0;
+		}
+		Log[LogTotal % LogCapacity] = MoveTemp(NewLog);
+	}
+	LogTotal++;
+}
+
+StringOutputDevice::StringOutputDevice()
+{
+	ExcludedCategories.Add(FName(TEXT("LogHAL")));
 }
 
 void StringOutputDevice::RegisterToLog()
 {
-	MyLog = "";
+	{
+		FScopeLock Lock(&ChunkCritical);
+		Chunk.Reset();
+		CapturedSize = 0;
+	}
 	if (GLog != nullptr)
 	{
 		bIsRegistered = true;
@@ -154,12 +353,171 @@ void StringOutputDevice::UnregisterFromLog()
 
 void StringOutputDevice::Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category)
 {
-	if (Category.ToString() != "LogHAL")
+	if ((Verbosity & ELogVerbosity::VerbosityMask) > MaxVerbosity || ExcludedCategories.Contains(Category))
+	{
+		return;
+	}
+	FScopeLock Lock(&ChunkCritical);
+	if (CapturedSize >= MaxCapturedSize)
+	{
+		return;
+	}
+	int32 MessageLength = FCString::Strlen(Message);
+	int64 PreviousLength = Chunk.Len();
+	Category.AppendString(Chunk);
+	Chunk += TEXT(" ");
+	Chunk.AppendChars(Message, MessageLength);
+	if (MessageLength == 0 || Message[MessageLength - 1] != TEXT('\n'))
+	{
+		Chunk += TEXT("\n");
+	}
+	CapturedSize += Chunk.Len() - PreviousLength;
+	if (CapturedSize >= MaxCapturedSize)
+	{
+		Chunk += TEXT("UtuPlugin: Maximum captured size reached, the rest of the Unreal log of this import is not captured.\n");
+	}
+	if (Chunk.Len() >= ChunkSize || CapturedSize >= MaxCapturedSize)
+	{
+		UUtuPluginLog::PrintIntoUnrealLogFile(MoveTemp(Chunk));
+		Chunk.Reset(ChunkSize + 1024);
+	}
+}
+
+void StringOutputDevice::FlushChunk(bool bFromCrash)
+{
+	// The crashing thread may be holding the lock
+	if (bFromCrash && !ChunkCritical.TryLock())
+	{
+		return;
+	}
+	if (bFromCrash)
+	{
+		ChunkCritical.Unlock();
+	}
+	FScopeLock Lock(&ChunkCritical);
+	if (Chunk.Len() > 0)
+	{
+		UUtuPluginLog::PrintIntoUnrealLogFile(MoveTemp(Chunk));
+		Chunk.Reset();
+	}
+}
+
+FUtuPluginEventStageTimer::FUtuPluginEventStageTimer(EUtuEventStage InStage)
+	: Stage(InStage)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FUtuPluginEventStageTimer::~FUtuPluginEventStageTimer()
+{
+	UUtuPluginLog::AddEventStageTime(Stage, FPlatformTime::Seconds() - StartTime);
+}
+
+FUtuPluginLogWriter::FUtuPluginLogWriter(FString ImportLogPath, FString UnrealLogPath, FString EventsPath)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	Files.SetNumZeroed((int32)EUtuLogFile::Count);
+	Files[(int32)EUtuLogFile::Import] = PlatformFile.OpenWrite(*ImportLogPath, true, true);
+	Files[(int32)EUtuLogFile::Unreal] = PlatformFile.OpenWrite(*UnrealLogPath, false, true);
+	Files[(int32)EUtuLogFile::Events] = PlatformFile.OpenWrite(*EventsPath, false, true);
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("UtuPluginLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+FUtuPluginLogWriter::~FUtuPluginLogWriter()
+{
+	if (Thread != nullptr)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+	if (WakeUpEvent != nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+		WakeUpEvent = nullptr;
+	}
+	Flush();
+	for (IFileHandle* File : Files)
+	{
+		delete File;
+	}
+	Files.Empty();
+}
+
+void FUtuPluginLogWriter::Write(EUtuLogFile File, FString Text)
+{
+	Queue.Enqueue({ File, MoveTemp(Text) });
+	if (Thread == nullptr && ++PendingCount >= 1000)
+	{
+		PendingCount = 0;
+		WritePending();
+	}
+}
+
+void FUtuPluginLogWriter::Flush(bool bFromCrash)
+{
+	if (bFromCrash)
+	{
+		// The writer thread may be the one that crashed while holding the lock
+		if (!WriteCritical.TryLock())
+		{
+			return;
+		}
+		WriteCritical.Unlock();
+	}
+	WritePending();
+	FScopeLock Lock(&WriteCritical);
+	for (IFileHandle* File : Files)
+	{
+		if (File != nullptr)
+		{
+			File->Flush();
+		}
+	}
+}
+
+uint32 FUtuPluginLogWriter::Run()
+{
+	while (!bStopping)
+	{
+		WakeUpEvent->Wait(100);
+		WritePending();
+	}
+	WritePending();
+	return 0;
+}
+
+void FUtuPluginLogWriter::Stop()
+{
+	bStopping = true;
+	if (WakeUpEvent != nullptr)
+	{
+		WakeUpEvent->Trigger();
+	}
+}
+
+void FUtuPluginLogWriter::WritePending()
+{
+	FScopeLock Lock(&WriteCritical);
+	// One write per file per batch
+	TArray<FString> Batches;
+	Batches.SetNum((int32)EUtuLogFile::Count);
+	FEntry Entry;
+	while (Queue.Dequeue(Entry))
+	{
+		Batches[(int32)Entry.File] += Entry.Text;
+	}
+	for (int32 Index = 0; Index < Batches.Num(); Index++)
 	{
-		MyLog += Category.ToString() + " " + Message;
-		if (!MyLog.EndsWith("\n"))
+		if (Files[Index] != nullptr && Batches[Index].Len() > 0)
 		{
-			MyLog += "\n";
+			FTCHARToUTF8 Utf8(*Batches[Index]);
+			Files[Index]->Write((const uint8*)Utf8.Get(), Utf8.Length());
 		}
 	}
 }
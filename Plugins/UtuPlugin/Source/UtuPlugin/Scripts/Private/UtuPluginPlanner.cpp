@@ -0,0 +1,252 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginPlanner.h"
+#include "UtuPlugin/Scripts/Public/UtuPlugin.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginCostModel.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include "Runtime/Core/Public/Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 3
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#else
+#include "Runtime/AssetRegistry/Public/AssetRegistryModule.h"
+#include "Runtime/AssetRegistry/Public/IAssetRegistry.h"
+#endif
+
+FUtuPluginPlan UUtuPluginPlanner::PlanImport(FUtuPluginJson Json, TArray<EUtuAssetType> AssetTypes) {
+	UTU_TRACE_SCOPE("UtuPlugin::PlanImport");
+	double StartTime = FPlatformTime::Seconds();
+	FUtuPluginPlan Plan;
+
+	// Same paths as the import
+	FUtuPluginCurrentImport DuplicateFinder;
+	DuplicateFinder.PopulateListOfDuplicatedAssetNames(Json);
+	FUtuPluginAssetTypeProcessor Proc;
+	Proc.ImportSettings = UUtuPlugin::currentImportSettings;
+	Proc.ListOfDuplicatedAssetNames = DuplicateFinder.ListOfDuplicatedAssetNames;
+
+	// One registry query instead of loading every asset
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets()) {
+		AssetRegistry.SearchAllAssets(true);
+	}
+	FARFilter Filter;
+	Filter.PackagePaths.Add("/Game");
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	TArray<FAssetData> AssetDatas;
+	AssetRegistry.GetAssets(Filter, AssetDatas);
+	TMap<FName, FName> ExistingAssets; // Package name -> class name of its main asset
+	ExistingAssets.Reserve(AssetDatas.Num());
+	for (const FAssetData& AssetData : AssetDatas) {
+		if (AssetData.AssetName.ToString() == FPackageName::GetShortName(AssetData.PackageName)) {
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+			ExistingAssets.Add(AssetData.PackageName, AssetData.AssetClassPath.GetAssetName());
+#else
+			ExistingAssets.Add(AssetData.PackageName, AssetData.AssetClass);
+#endif
+		}
+	}
+
+	TMap<FString, FString> PlannedPaths; // Unreal path -> Unity path
+	if (AssetTypes.Contains(EUtuAssetType::Texture)) {
+		for (int x = 0; x < Json.textures.Num(); x++) {
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::Texture, x, Json.textures[x].asset_relative_filename, EUtuUnrealAssetType::Texture, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::Material)) {
+		for (int x = 0; x < Json.materials.Num(); x++) {
+			if (Json.materials[x].asset_relative_filename.StartsWith("Resources")) {
+				FUtuPluginPlanEntry Entry;
+				Entry.AssetType = EUtuAssetType::Material;
+				Entry.UnityPath = Json.materials[x].asset_relative_filename;
+				Entry.Action = EUtuPlanAction::Skip;
+				Entry.Reason = "Default Unity material";
+				AddEntry(Plan, Entry);
+				continue;
+			}
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::Material, x, Json.materials[x].asset_relative_filename, Proc.ImportSettings.Materials.bCreateMaterialInstances ? EUtuUnrealAssetType::MaterialInstance : EUtuUnrealAssetType::Material, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::Mesh)) {
+		for (int x = 0; x < Json.meshes.Num(); x++) {
+			const FUtuPluginMesh& Mesh = Json.meshes[x];
+			if (!Mesh.asset_relative_filename.StartsWith("Assets") && !Mesh.asset_relative_filename.StartsWith("Packages")) {
+				FUtuPluginPlanEntry Entry;
+				Entry.AssetType = EUtuAssetType::Mesh;
+				Entry.UnityPath = Mesh.asset_relative_filename;
+				Entry.Action = EUtuPlanAction::Skip;
+				Entry.Reason = "Default Unity mesh";
+				AddEntry(Plan, Entry);
+				continue;
+			}
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::Mesh, x, Mesh.asset_relative_filename, Mesh.is_skeletal_mesh ? EUtuUnrealAssetType::SkeletalMesh : EUtuUnrealAssetType::StaticMesh, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::Animation)) {
+		for (int x = 0; x < Json.animations.Num(); x++) {
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::Animation, x, Json.animations[x].asset_relative_filename, EUtuUnrealAssetType::Animation, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::PrefabFirstPass)) {
+		for (int x = 0; x < Json.prefabs_first_pass.Num(); x++) {
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::PrefabFirstPass, x, Json.prefabs_first_pass[x].asset_relative_filename, EUtuUnrealAssetType::Blueprint, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::PrefabSecondPass)) {
+		for (int x = 0; x < Json.prefabs_second_pass.Num(); x++) {
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::PrefabSecondPass, x, Json.prefabs_second_pass[x].asset_relative_filename, EUtuUnrealAssetType::Blueprint, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+	if (AssetTypes.Contains(EUtuAssetType::Scene)) {
+		for (int x = 0; x < Json.scenes.Num(); x++) {
+			AddEntry(Plan, PlanAsset(Json, EUtuAssetType::Scene, x, Json.scenes[x].asset_relative_filename, EUtuUnrealAssetType::Level, Proc, ExistingAssets, PlannedPaths));
+		}
+	}
+
+	Plan.PlanningSeconds = FPlatformTime::Seconds() - StartTime;
+	WritePlan(Plan, Json.json_info.json_file_fullname);
+	return Plan;
+}
+
+FUtuPluginPlanEntry UUtuPluginPlanner::PlanAsset(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index, FString UnityPath, EUtuUnrealAssetType UnrealAssetType, FUtuPluginAssetTypeProcessor& Proc, const TMap<FName, FName>& ExistingAssets, TMap<FString, FString>& PlannedPaths) {
+	FUtuPluginPlanEntry Entry;
+	Entry.AssetType = AssetType;
+	Entry.UnityPath = UnityPath;
+	Entry.UnrealPath = Proc.FormatRelativeFilenameForUnreal(UnityPath, UnrealAssetType)[2];
+
+	// Two assets of this import on the same path. The second pass of the prefabs updates the blueprints of the first pass.
+	bool bPlannedByFirstPass = false;
+	if (AssetType == EUtuAssetType::PrefabSecondPass) {
+		bPlannedByFirstPass = PlannedPaths.Contains(Entry.UnrealPath);
+	}
+	else if (const FString* OtherUnityPath = PlannedPaths.Find(Entry.UnrealPath)) {
+		Entry.Action = EUtuPlanAction::Conflict;
+		Entry.Reason = "Same Unreal path as '" + *OtherUnityPath + "'";
+		return Entry;
+	}
+	else {
+		PlannedPaths.Add(Entry.UnrealPath, UnityPath);
+	}
+
+	// Existing asset
+	FName ExpectedClass;
+	EUtuProcessingBehavior ProcessingBehavior = EUtuProcessingBehavior::AlwaysProcess;
+	bool bIsImportedFromFile = false;
+	switch (UnrealAssetType) {
+	case EUtuUnrealAssetType::Level:
+		ExpectedClass = "World";
+		ProcessingBehavior = Proc.ImportSettings.Scenes.ProcessingBehavior;
+		break;
+	case EUtuUnrealAssetType::Animation:
+		ExpectedClass = "AnimSequence";
+		ProcessingBehavior = Proc.ImportSettings.Animations.ProcessingBehavior;
+		bIsImportedFromFile = true;
+		break;
+	case EUtuUnrealAssetType::StaticMesh:
+		ExpectedClass = "StaticMesh";
+		ProcessingBehavior = Proc.ImportSettings.StaticMeshes.ProcessingBehavior;
+		bIsImportedFromFile = true;
+		break;
+	case EUtuUnrealAssetType::SkeletalMesh:
+		ExpectedClass = "SkeletalMesh";
+		ProcessingBehavior = Proc.ImportSettings.SkeletalMeshes.ProcessingBehavior;
+		bIsImportedFromFile = true;
+		break;
+	case EUtuUnrealAssetType::Material:
+		ExpectedClass = "Material";
+		ProcessingBehavior = Proc.ImportSettings.Materials.ProcessingBehavior;
+		break;
+	case EUtuUnrealAssetType::MaterialInstance:
+		ExpectedClass = "MaterialInstanceConstant";
+		ProcessingBehavior = Proc.ImportSettings.Materials.ProcessingBehavior;
+		break;
+	case EUtuUnrealAssetType::Texture:
+		ExpectedClass = "Texture2D";
+		ProcessingBehavior = Proc.ImportSettings.Textures.ProcessingBehavior;
+		bIsImportedFromFile = true;
+		break;
+	case EUtuUnrealAssetType::Blueprint:
+	default:
+		ExpectedClass = "Blueprint";
+		ProcessingBehavior = Proc.ImportSettings.Blueprints.ProcessingBehavior;
+		break;
+	}
+	const FName* ExistingClass = ExistingAssets.Find(FName(*Entry.UnrealPath));
+	bool bExists = ExistingClass != nullptr || bPlannedByFirstPass;
+	if (ExistingClass != nullptr && *ExistingClass != ExpectedClass) {
+		if (!Proc.ImportSettings.bDeleteInvalidAssets) {
+			Entry.Action = EUtuPlanAction::Conflict;
+			Entry.Reason = "Existing asset is a '" + ExistingClass->ToString() + "' and 'bDeleteInvalidAssets' is disabled";
+			return Entry;
+		}
+		bExists = bPlannedByFirstPass;
+		Entry.Reason = "Replaces the existing '" + ExistingClass->ToString() + "'";
+	}
+
+	// Same order as the import
+	if (ProcessingBehavior == EUtuProcessingBehavior::DoNotProcess) {
+		Entry.Action = EUtuPlanAction::Skip;
+		Entry.Reason = "Processing behavior is set to 'DoNotProcess'";
+		return Entry;
+	}
+	if (bExists && ProcessingBehavior == EUtuProcessingBehavior::SkipExisting) {
+		Entry.Action = EUtuPlanAction::Skip;
+		Entry.Reason = "Processing behavior is set to 'SkipExisting' and asset exists";
+		return Entry;
+	}
+	if (bExists && bIsImportedFromFile && ProcessingBehavior == EUtuProcessingBehavior::UpdateExisting) {
+		Entry.Action = EUtuPlanAction::Update;
+		Entry.Reason = "Not re-imported, processing behavior is set to 'UpdateExisting'";
+		Entry.EstimatedSeconds = UtuPluginCostModel::EstimateSeconds(AssetType, 0.0);
+		return Entry;
+	}
+	Entry.Action = bExists ? EUtuPlanAction::Reimport : EUtuPlanAction::Create;
+	Entry.EstimatedSeconds = UtuPluginCostModel::EstimateSeconds(AssetType, UtuPluginCostModel::GetAssetUnits(Json, AssetType, Index));
+	Entry.SourceBytes = UtuPluginCostModel::GetAssetSourceBytes(Json, AssetType, Index);
+	return Entry;
+}
+
+void UUtuPluginPlanner::AddEntry(FUtuPluginPlan& OutPlan, FUtuPluginPlanEntry Entry) {
+	switch (Entry.Action) {
+	case EUtuPlanAction::Create:
+		OutPlan.CreateCount++;
+		break;
+	case EUtuPlanAction::Reimport:
+		OutPlan.ReimportCount++;
+		break;
+	case EUtuPlanAction::Update:
+		OutPlan.UpdateCount++;
+		break;
+	case EUtuPlanAction::Skip:
+		OutPlan.SkipCount++;
+		break;
+	case EUtuPlanAction::Conflict:
+		OutPlan.ConflictCount++;
+		break;
+	}
+	OutPlan.EstimatedSeconds += Entry.EstimatedSeconds;
+	OutPlan.SourceBytes += Entry.SourceBytes;
+	OutPlan.Entries.Add(MoveTemp(Entry));
+}
+
+void UUtuPluginPlanner::WritePlan(const FUtuPluginPlan& Plan, FString JsonFileFullname) {
+	FString JsonPath, DummyName, DummyExtension;
+	FPaths::Split(JsonFileFullname, JsonPath, DummyName, DummyExtension);
+	if (JsonPath == "") {
+		return;
+	}
+	UEnum* AssetTypeEnum = StaticEnum<EUtuAssetType>();
+	UEnum* ActionEnum = StaticEnum<EUtuPlanAction>();
+	TArray<FString> Lines;
+	Lines.Reserve(Plan.Entries.Num() + 1);
+	Lines.Add("AssetType,Action,UnityPath,UnrealPath,Reason,EstimatedSeconds,SourceBytes");
+	for (const FUtuPluginPlanEntry& Entry : Plan.Entries) {
+		Lines.Add(FString::Printf(TEXT("%s,%s,\"%s\",\"%s\",\"%s\",%.3f,%lld"), *AssetTypeEnum->GetNameStringByValue((int64)Entry.AssetType), *ActionEnum->GetNameStringByValue((int64)Entry.Action), *Entry.UnityPath, *Entry.UnrealPath, *Entry.Reason.Replace(TEXT("\""), TEXT("'")), Entry.EstimatedSeconds, Entry.SourceBytes));
+	}
+	FFileHelper::SaveStringArrayToFile(Lines, *(JsonPath + UtuPluginPaths::slash + "UnrealImportPlan.csv"));
+}
@@ -0,0 +1,76 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
+#include "UObject/Package.h"
+
+UE_TRACE_CHANNEL_DEFINE(UtuPluginChannel);
+
+DEFINE_STAT(STAT_UtuPlugin_AssetsProcessed);
+DEFINE_STAT(STAT_UtuPlugin_TexturesPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_MaterialsPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_MeshesPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_AnimationsPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_PrefabsPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_ScenesPerSecond);
+DEFINE_STAT(STAT_UtuPlugin_TextureCacheHitRate);
+DEFINE_STAT(STAT_UtuPlugin_ExpressionIndexHitRate);
+DEFINE_STAT(STAT_UtuPlugin_PackagesDirtied);
+
+FDelegateHandle UtuPluginProfiling::PackageMarkedDirtyHandle;
+int UtuPluginProfiling::TextureCacheLookups = 0;
+int UtuPluginProfiling::TextureCacheHits = 0;
+int UtuPluginProfiling::ExpressionIndexLookups = 0;
+int UtuPluginProfiling::ExpressionIndexHits = 0;
+
+void UtuPluginProfiling::BeginImport() {
+	TextureCacheLookups = 0;
+	TextureCacheHits = 0;
+	ExpressionIndexLookups = 0;
+	ExpressionIndexHits = 0;
+	SET_DWORD_STAT(STAT_UtuPlugin_AssetsProcessed, 0);
+	SET_FLOAT_STAT(STAT_UtuPlugin_TexturesPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_MaterialsPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_MeshesPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_AnimationsPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_PrefabsPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_ScenesPerSecond, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_TextureCacheHitRate, 0.0f);
+	SET_FLOAT_STAT(STAT_UtuPlugin_ExpressionIndexHitRate, 0.0f);
+	SET_DWORD_STAT(STAT_UtuPlugin_PackagesDirtied, 0);
+	if (!PackageMarkedDirtyHandle.IsValid()) {
+		PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddStatic(&UtuPluginProfiling::OnPackageMarkedDirty);
+	}
+}
+
+void UtuPluginProfiling::CompleteImport() {
+	if (PackageMarkedDirtyHandle.IsValid()) {
+		UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+		PackageMarkedDirtyHandle.Reset();
+	}
+}
+
+void UtuPluginProfiling::RecordTextureCacheLookup(bool bHit) {
+	TextureCacheLookups++;
+	TextureCacheHits += bHit ? 1 : 0;
+	SET_FLOAT_STAT(STAT_UtuPlugin_TextureCacheHitRate, 100.0f * TextureCacheHits / TextureCacheLookups);
+}
+
+void UtuPluginProfiling::RecordExpressionIndexLookup(bool bHit) {
+	ExpressionIndexLookups++;
+	ExpressionIndexHits += bHit ? 1 : 0;
+	SET_FLOAT_STAT(STAT_UtuPlugin_ExpressionIndexHitRate, 100.0f * ExpressionIndexHits / ExpressionIndexLookups);
+}
+
+float UtuPluginProfiling::GetTextureCacheHitRate() {
+	return TextureCacheLookups > 0 ? 100.0f * TextureCacheHits / TextureCacheLookups : 0.0f;
+}
+
+float UtuPluginProfiling::GetExpressionIndexHitRate() {
+	return ExpressionIndexLookups > 0 ? 100.0f * ExpressionIndexHits / ExpressionIndexLookups : 0.0f;
+}
+
+void UtuPluginProfiling::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty) {
+	if (!bWasDirty) {
+		INC_DWORD_STAT(STAT_UtuPlugin_PackagesDirtied);
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#include "UtuPlugin/Scripts/Public/UtuPluginReport.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginPaths.h"
+#include "Runtime/Core/Public/Misc/FileHelper.h"
+#include "HAL/PlatformMemory.h"
+
+TArray<FUtuPluginReportAsset> UtuPluginReport::Assets;
+TArray<FUtuPluginReportPhase> UtuPluginReport::Phases;
+double UtuPluginReport::ImportStartTime = 0.0;
+
+void UtuPluginReport::BeginImport() {
+	Assets.Empty();
+	Phases.Empty();
+	ImportStartTime = FPlatformTime::Seconds();
+}
+
+void UtuPluginReport::BeginPhase(FString Phase) {
+	EndPhase();
+	FUtuPluginReportPhase NewPhase;
+	NewPhase.Phase = Phase;
+	NewPhase.StartTime = FPlatformTime::Seconds();
+	Phases.Add(NewPhase);
+	SampleMemory();
+}
+
+void UtuPluginReport::EndPhase() {
+	if (Phases.Num() > 0 && Phases.Last().Seconds == 0.0) {
+		SampleMemory();
+		Phases.Last().Seconds = FPlatformTime::Seconds() - Phases.Last().StartTime;
+	}
+}
+
+void UtuPluginReport::AddAsset(const FUtuPluginAssetEvent& Event, double Seconds) {
+	FUtuPluginReportAsset Asset;
+	Asset.Phase = Phases.Num() > 0 ? Phases.Last().Phase : "";
+	Asset.AssetType = Event.AssetType;
+	Asset.UnrealPath = Event.UnrealPath;
+	Asset.Outcome = Event.GetOutcome();
+	Asset.Seconds = Seconds;
+	for (int32 Stage = 0; Stage < (int32)EUtuEventStage::Count; Stage++) {
+		Asset.StageTimes[Stage] = Event.StageTimes[Stage];
+		if (Phases.Num() > 0) {
+			Phases.Last().StageTimes[Stage] += Event.StageTimes[Stage];
+		}
+	}
+	if (Phases.Num() > 0) {
+		Phases.Last().AssetCount++;
+	}
+	Assets.Add(MoveTemp(Asset));
+	SampleMemory();
+}
+
+void UtuPluginReport::AddSave(double Seconds) {
+	if (Phases.Num() > 0) {
+		Phases.Last().SaveSeconds += Seconds;
+	}
+}
+
+void UtuPluginReport::SampleMemory() {
+	if (Phases.Num() > 0) {
+		Phases.Last().PeakUsedPhysical = FMath::Max(Phases.Last().PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+FString UtuPluginReport::Escape(FString InText) {
+	return InText.Replace(TEXT("&"), TEXT("&amp;")).Replace(TEXT("<"), TEXT("&lt;")).Replace(TEXT(">"), TEXT("&gt;"));
+}
+
+void UtuPluginReport::WriteReport(FString Folder, int SlowestAssetCount) {
+	EndPhase();
+	double TotalSeconds = FPlatformTime::Seconds() - ImportStartTime;
+
+	// Csv: one line per asset
+	FString Csv = "Phase,AssetType,UnrealPath,Outcome,Seconds,LookupSeconds,ImportSeconds,PostEditSeconds\n";
+	for (const FUtuPluginReportAsset& Asset : Assets) {
+		Csv += FString::Printf(TEXT("%s,%s,\"%s\",%s,%.4f,%.4f,%.4f,%.4f\n"), *Asset.Phase, *Asset.AssetType, *Asset.UnrealPath, *Asset.Outcome, Asset.Seconds, Asset.StageTimes[(int32)EUtuEventStage::Lookup], Asset.StageTimes[(int32)EUtuEventStage::Import], Asset.StageTimes[(int32)EUtuEventStage::PostEdit]);
+	}
+	FFileHelper::SaveStringToFile(Csv, *(Folder + UtuPluginPaths::slash + "UnrealImportReport.csv"));
+
+	// Html
+	FString Html = "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Utu Plugin - Import Report</title><style>"
+		"body{font-family:sans-serif;font-size:13px;margin:24px;}table{border-collapse:collapse;margin-bottom:24px;}"
+		"th,td{border:1px solid #ccc;padding:4px 8px;text-align:right;}th{background:#eee;}td.l{text-align:left;}"
+		"</style></head><body>";
+	Html += "<h1>Import Report</h1><p>Total: " + FString::Printf(TEXT("%.1f"), TotalSeconds) + " seconds, " + FString::FromInt(Assets.Num()) + " assets. Generated " + FDateTime::UtcNow().ToString() + " UTC.</p>";
+
+	// Phases
+	Html += "<h2>Phases</h2><table><tr><th>Phase</th><th>Assets</th><th>Seconds</th><th>% of import</th><th>Assets/s</th><th>Lookup s</th><th>Import (FBX parse + build) s</th><th>Post edit s</th><th>Save s</th><th>Peak memory MB</th></tr>";
+	for (const FUtuPluginReportPhase& Phase : Phases) {
+		Html += "<tr><td class=\"l\">" + Escape(Phase.Phase) + "</td>";
+		Html += FString::Printf(TEXT("<td>%d</td><td>%.2f</td><td>%.1f</td><td>%.2f</td><td>%.2f</td><td>%.2f</td><td>%.2f</td><td>%.2f</td><td>%.0f</td></tr>"),
+			Phase.AssetCount, Phase.Seconds, 100.0 * Phase.Seconds / FMath::Max(TotalSeconds, 0.001), Phase.AssetCount / FMath::Max(Phase.Seconds, 0.001),
+			Phase.StageTimes[(int32)EUtuEventStage::Lookup], Phase.StageTimes[(int32)EUtuEventStage::Import], Phase.StageTimes[(int32)EUtuEventStage::PostEdit], Phase.SaveSeconds,
+			Phase.PeakUsedPhysical / (1024.0 * 1024.0));
+	}
+	Html += "</table>";
+
+	// Caches
+	Html += "<h2>Caches</h2><table><tr><th>Cache</th><th>Hit rate %</th></tr>";
+	Html += FString::Printf(TEXT("<tr><td class=\"l\">Texture cache</td><td>%.1f</td></tr>"), UtuPluginProfiling::GetTextureCacheHitRate());
+	Html += FString::Printf(TEXT("<tr><td class=\"l\">Material expression index</td><td>%.1f</td></tr>"), UtuPluginProfiling::GetExpressionIndexHitRate());
+	Html += "</table>";
+
+	// Slowest assets per type
+	TMap<FString, TArray<const FUtuPluginReportAsset*>> AssetsPerType;
+	for (const FUtuPluginReportAsset& Asset : Assets) {
+		AssetsPerType.FindOrAdd(Asset.AssetType).Add(&Asset);
+	}
+	Html += "<h2>Slowest Assets</h2>";
+	for (TPair<FString, TArray<const FUtuPluginReportAsset*>>& Type : AssetsPerType) {
+		Type.Value.Sort([](const FUtuPluginReportAsset& A, const FUtuPluginReportAsset& B) { return A.Seconds > B.Seconds; });
+		Html += "<h3>" + Escape(Type.Key) + "</h3><table><tr><th>Unreal Path</th><th>Outcome</th><th>Seconds</th><th>Lookup s</th><th>Import s</th><th>Post edit s</th></tr>";
+		for (int x = 0; x < FMath::Min(SlowestAssetCount, Type.Value.Num()); x++) {
+			const FUtuPluginReportAsset& Asset = *Type.Value[x];
+			Html += "<tr><td class=\"l\">" + Escape(Asset.UnrealPath) + "</td><td class=\"l\">" + Escape(Asset.Outcome) + "</td>";
+			Html += FString::Printf(TEXT("<td>%.3f</td><td>%.3f</td><td>%.3f</td><td>%.3f</td></tr>"), Asset.Seconds, Asset.StageTimes[(int32)EUtuEventStage::Lookup], Asset.StageTimes[(int32)EUtuEventStage::Import], Asset.StageTimes[(int32)EUtuEventStage::PostEdit]);
+		}
+		Html += "</table>";
+	}
+	Html += "</body></html>";
+	FFileHelper::SaveStringToFile(Html, *(Folder + UtuPluginPaths::slash + "UnrealImportReport.html"), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
@@ -20,6 +20,8 @@ public:
 	bool ContinueImport(bool executeFullImportOnSameFrame);
 	void CompleteImport();
 	FString AssetTypeToString(EUtuAssetType AssetType);
+	int GetAssetsNum(EUtuAssetType AssetType);
+	double EstimateNextAssetSeconds();
 
 	TArray<FString> ListOfDuplicatedAssetNames = TArray<FString>();
 	void PopulateListOfDuplicatedAssetNames(FUtuPluginJson Json);
@@ -27,6 +29,7 @@ public:
 public:
 	// Global
 	FUtuPluginJson json;
+	TSharedPtr<FUtuPluginImportCache> ImportCache;
 	UPROPERTY()
 		FString timestamp = "";
 	// Delayed Specific
@@ -67,6 +70,7 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 		static void CancelImport();
 	
+	// Copies the whole import, json included. To follow the progress, bind to UUtuPluginImportEvents instead.
 	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 		static FUtuPluginCurrentImport GetCurrentImportState();
 
@@ -88,7 +92,8 @@ public:
 	UFUNCTION(BlueprintPure, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 		static bool IsGarbageCollecting();
 		
-	static FUtuPluginCurrentImport ContinueCurrentImport();
+	static void ContinueCurrentImport();
+	static void ContinueCurrentImportWithinBudget(double BudgetSeconds);
 private:
 	static FUtuPluginCurrentImport currentImportJob;
 public:
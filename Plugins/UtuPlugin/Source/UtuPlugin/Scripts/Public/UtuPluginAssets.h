@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "Factories/FbxMeshImportData.h"
 #include "Engine/Texture.h"
+#include "Engine/EngineTypes.h"
 #include "UtuPluginAssets.generated.h"
 
 class FAssetToolsModule;
@@ -16,11 +17,13 @@ class USCS_Node;
 class UPackage;
 class ACineCamera;
 class UCineCameraComponent;
+class UMaterialExpression;
 class UMaterialExpressionTextureSampleParameter2D;
 class UMaterialExpressionScalarParameter;
 class UMaterialExpressionVectorParameter;
 class UMaterial;
 class UTexture;
+class UMaterialInterface;
 class UMaterialExpressionMultiply;
 class UMaterialExpressionPanner;
 class UMaterialExpressionTextureCoordinate;
@@ -29,6 +32,7 @@ class UStaticMesh;
 class USkeletalMesh;
 class USkeletalMeshComponent;
 class UTexture2D;
+class UInstancedStaticMeshComponent;
 struct FStaticMaterial;
 
 UENUM(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
@@ -55,6 +59,12 @@ enum class EUtuMeshSpawnBehavior : uint8
 	AllPrefab, StaticMeshIfAloneInPrefab, AllStaticMesh
 };
 
+UENUM(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+enum class EUtuNonPowerOfTwoBehavior : uint8
+{
+	KeepAsIs, PadToPowerOfTwo, ResizeToPowerOfTwo
+};
+
 
 USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 struct UTUPLUGIN_API FUtuFindAndReplace
@@ -255,6 +265,8 @@ struct UTUPLUGIN_API FUtuPluginImportSettings_Blueprints : public FUtuPluginImpo
 
 public:
 	// Blueprints
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bPackStaticPrefabs = false;
 };
 
 USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
@@ -266,6 +278,27 @@ public:
 	// Scenes
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 	EUtuMeshSpawnBehavior MeshSpawnBehavior = EUtuMeshSpawnBehavior::StaticMeshIfAloneInPrefab;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bDiffReimport = true;
+	// Native actors finish their construction once placed and parented, and the spawned actors register the components added by the import in one pass at the end.
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bBatchSpawnActors = false;
+	// World Partition
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bCreateWorldPartition = false;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int WorldPartitionCellSize = 25600;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float WorldPartitionLoadingRange = 25600.0f;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bCreateDataLayersFromTags = false;
+	// Instancing
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bInstanceStaticMeshActors = false;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bUseHierarchicalInstances = true;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int MinInstancesPerGroup = 2;
 };
 
 
@@ -314,6 +347,24 @@ public:
 	TEnumAsByte<enum ETextureCompressionQuality> CompressionQuality = ETextureCompressionQuality::TCQ_Default;
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 	TEnumAsByte<enum TextureMipGenSettings> MipGenSettings = TextureMipGenSettings::TMGS_FromTextureGroup;
+	// Deduplication
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bDeduplicateTextures = false;
+	// Texel Density
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bTexelDensityAnalysis = false;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float TargetTexelDensity = 10.24f; // Texels per centimeter, measured from the UV density of the mesh sections using the texture
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int32 MinTextureSize = 64;
+	// Virtual Textures
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bConvertLargeTexturesToVirtual = false;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int32 VirtualTextureMinSize = 4096;
+	// Non Power Of Two
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	EUtuNonPowerOfTwoBehavior NonPowerOfTwoBehavior = EUtuNonPowerOfTwoBehavior::KeepAsIs;
 };
 
 
@@ -355,6 +406,22 @@ public:
 	bool bOverrideRoughnessMultiplier = false;
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 	float RoughnessMultiplier = 1.0f;
+	// Deduplication
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bDeduplicateMaterialInstances = false;
+	// Shader Compilation
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bBatchShaderCompilation = false;
+	// Only with 'bBatchShaderCompilation'. Blocks until the shaders of the imported materials are compiled, can be cancelled.
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bWaitForShaderCompilation = true;
+	// ORM Packing
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bPackOrmTextures = false;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString OrmMetallicSmoothnessTextureName = "_MetallicGlossMap";
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString OrmOcclusionTextureName = "_OcclusionMap";
 };
 
 
@@ -380,6 +447,14 @@ public:
 	EUtuSavingBehavior SavingBehavior = EUtuSavingBehavior::PromptAtEnd;
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 	int SavingIntervals = 100;
+	// 0 = one asset every 10 editor ticks. Otherwise, assets are processed every 10 editor ticks while the cost model predicts they fit in the budget.
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float TickTimeBudgetMs = 0.0f;
+	// Report
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bWriteImportReport = true;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ReportSlowestAssetCount = 20;
 
 public:
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
@@ -403,6 +478,37 @@ public:
 };
 
 
+// Unity texture resolved once per import and shared by every asset type processor
+struct FUtuPluginCachedTexture
+{
+	FString AssetRelativeFilename;
+	TWeakObjectPtr<UTexture2D> Texture;
+	bool bExists = false;
+};
+
+struct FUtuPluginImportCache
+{
+	TMap<FString, FUtuPluginCachedTexture> Textures; // Unity relative filename -> texture, misses are cached too
+	TWeakObjectPtr<UTexture2D> FallbackTexture;
+	TWeakObjectPtr<UTexture2D> VirtualFallbackTexture;
+	bool bTextureRedirectsBuilt = false;
+	TMap<FString, FString> TextureRedirects; // Unity texture -> Unity texture with the same file content
+	int64 TextureRedirectsSavedBytes = 0;
+	TArray<FString> NonPowerOfTwoTextures; // Report of the textures that can't mip or stream as imported
+};
+
+// Parameters a material instance should end up with, so reimports only touch what changed
+struct FUtuMaterialInstanceTarget
+{
+	UMaterialInterface* Parent = nullptr;
+	bool bTwoSided = false;
+	bool bHasBlendMode = false;
+	TEnumAsByte<EBlendMode> BlendMode = EBlendMode::BLEND_Opaque;
+	TMap<FName, float> Scalars;
+	TMap<FName, FLinearColor> Vectors;
+	TMap<FName, UTexture*> Textures;
+};
+
 USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 struct UTUPLUGIN_API FUtuPluginAssetTypeProcessor {
 	GENERATED_USTRUCT_BODY()
@@ -411,11 +517,13 @@ public:
 	void BeginImport(FUtuPluginJson Json, EUtuAssetType AssetType, TArray<FString> DuplicatedAssetNames);
 	bool ContinueImport();
 	void CompleteImport();
+	void CancelImport();
 
 	TArray<FString> ListOfDuplicatedAssetNames = TArray<FString>();
 
 public:
 	int GetAssetsNum();
+	double EstimateNextAssetSeconds();
 	TArray<FString> FormatRelativeFilenameForUnreal(FString InRelativeFilename, EUtuUnrealAssetType AssetType); //[0] = path, [1] = name, [2] = relative filename
 	TArray<FString> FormatRelativeFilenameForUnrealSeparated(FString InRelativeFilename, FString InRelativeFilenameSeparated, EUtuUnrealAssetType AssetType);
 
@@ -426,6 +534,16 @@ private:
 	void ProcessMesh(FUtuPluginMesh InUtuMesh);
 	void ProcessMaterial(FUtuPluginMaterial InUtuMaterial);
 	class UMaterial* GetOrCreateParentMaterial(FUtuPluginMaterial InUtuMaterial);
+	FUtuMaterialInstanceTarget BuildMaterialInstanceTarget(FUtuPluginMaterial InUtuMaterial, UMaterial* InParentMaterial);
+	bool ApplyMaterialInstanceTarget(class UMaterialInstanceConstant* InAsset, const FUtuMaterialInstanceTarget& InTarget);
+	void MaterialPostEditChange(UMaterialInterface* InMaterial);
+	void BuildPackedOrmTextures();
+	void ApplyPackedOrmTexture(FUtuPluginMaterial InUtuMaterial, FUtuMaterialInstanceTarget& InOutTarget);
+	UMaterial* GetOrCreateOrmParentMaterial(UMaterial* InParentMaterial, UTexture* InDefaultTexture);
+	bool RewireOrmSamplers(UMaterial* InMaterial, UTexture* InDefaultTexture, bool bCheckOnly);
+	void ApplyVirtualTextures(FUtuMaterialInstanceTarget& InOutTarget);
+	bool SetVirtualSamplers(UMaterial* InMaterial, const TSet<FName>& InParameterNames, bool bCheckOnly);
+	void FlushDeferredMaterials();
 	void ProcessTexture(FUtuPluginTexture InUtuTexture);
 	void ProcessPrefabFirstPass(FUtuPluginPrefabFirstPass InUtuPrefabFirstPass);
 	void ProcessPrefabSecondPass(FUtuPluginPrefabSecondPass InUtuPrefabSecondPass);
@@ -439,6 +557,8 @@ private:
 	void LogAssetImportOrReimport(UObject* InAsset);
 	void LogAssetImportedOrFailed(UObject* InAsset, TArray<FString> InAssetNames, FString InSourceFileFullname, FString InAssetType, TArray<FString> InPotentialCauses);
 
+	AActor* WorldSpawnActor(UWorld* InAsset, UClass* InClass);
+	void WorldRegisterComponent(UActorComponent* InComponent);
 	AActor* WorldAddRootActorForSubActorsIfNeeded(UWorld* InAsset, FUtuPluginActor InUtuActor);
 	AActor* WorldSpawnStaticMeshActor(UWorld* InAsset, FUtuPluginActor InUtuActor);
 	AActor* WorldSpawnSkeletalMeshActor(UWorld* InAsset, FUtuPluginActor InUtuActor);
@@ -448,6 +568,19 @@ private:
 	AActor* WorldSpawnDirectionalLightActor(UWorld* InAsset, FUtuPluginActor InUtuActor);
 	AActor* WorldSpawnSpotLightActor(UWorld* InAsset, FUtuPluginActor InUtuActor);
 	AActor* WorldSpawnCameraActor(UWorld* InAsset, FUtuPluginActor InUtuActor);
+	TSet<int> WorldSpawnInstancedStaticMeshActors(UWorld* InAsset, TArray<FUtuPluginActor> InUtuActors, TMap<int, AActor*>& OutIdToActor, TMap<AActor*, int>& OutActorToParentId, TMap<FString, AActor*>& InOutOldGroups);
+	void WorldUpdateExistingActor(AActor* InActor, FUtuPluginActor InUtuActor);
+	void WorldSetupWorldPartition(UWorld* InAsset, TArray<FUtuPluginActor> InUtuActors, const TMap<int, AActor*>& InIdToActor);
+	FString WorldGetActorSignature(FUtuPluginActor InUtuActor);
+	FString WorldGetActorMeshSignature(FUtuPluginActor InUtuActor);
+	static int GetActorUtuId(AActor* InActor);
+	static FString GetActorTagValue(AActor* InActor, FString InPrefix);
+	static void SetActorTagValue(AActor* InActor, FString InPrefix, FString InValue);
+	bool WorldCanBeInstanced(FUtuPluginActor InUtuActor, const TSet<int>& InParentIds);
+	UStaticMesh* WorldGetStaticMeshAsset(FUtuPluginActor InUtuActor);
+	bool IsUtuGeneratedLod(FString InMeshRelativeFilename);
+	static TArray<int> GetInstancesActorIds(UInstancedStaticMeshComponent* InComponent);
+	static FName MakeInstanceTag(FUtuPluginActor InUtuActor);
 
 	void BpAddRootComponent(UBlueprint* InAsset, bool bStatic);
 	bool BpAddRootComponentForSubComponentsIfNeeded(UBlueprint* InAsset, FUtuPluginActor InPrefabComponent, FString InUniqueName, USCS_Node*& OutComponentNode);
@@ -460,6 +593,9 @@ private:
 	void BpAddCameraComponent(UBlueprint* InAsset, FUtuPluginActor InPrefabComponent, FString InUniqueName, USCS_Node*& OutComponentNode, bool bInRootCreated);
 	void BpAddChildActorComponent(UBlueprint* InAsset, FUtuPluginActor InPrefabComponent, FString InUniqueName, USCS_Node*& OutComponentNode, bool bInRootCreated);
 
+	bool BpCanBePacked(FUtuPluginPrefabSecondPass InUtuPrefabSecondPass);
+	void BpAddPackedInstancedComponents(UBlueprint* InAsset, FUtuPluginPrefabSecondPass InUtuPrefabSecondPass, USCS_Node* InRootNode);
+
 	FString BpMakeUniqueName(FString InDesiredName, TArray<FString>& InOutUsedNames);
 	UStaticMesh* GetMeshAsset(TArray<FString> AssetNames);
 	TArray<FString> CalculateMaterialsSlotOrder(TArray<FString> Materials, TArray<FStaticMaterial> Slots);
@@ -467,6 +603,19 @@ private:
 	void AssignMaterialsToMesh(TArray<FString> Materials, UStaticMeshComponent* StaticMeshComponent);
 	void AssignMaterialsToMesh(TArray<FString> Materials, USkeletalMesh* SkeletalMesh);
 	void AssignMaterialsToMesh(TArray<FString> Materials, USkeletalMeshComponent* SkeletalMeshComponent);
+	UMaterialInterface* GetMaterialFromUnityRelativeFilename(FString InUnityRelativeFilename, FString& OutAssetRelativeFilename);
+
+	void BuildMaterialRedirects();
+	void BuildTextureRedirects();
+	FString GetTextureRedirect(FString InUnityRelativeFilename);
+	void AnalyzeTexelDensity();
+	void ProcessNonPowerOfTwoTexture(UTexture2D* InTexture, FString InUnityRelativeFilename);
+	bool CanScaleTextureCoordinates(FString InUnityRelativeFilename);
+	void BuildUnpaddableTextures();
+	bool ResizeTextureToPowerOfTwo(UTexture2D* InTexture);
+	void ApplyPaddedTextureScale(FUtuMaterialInstanceTarget& InOutTarget);
+	FString GetMaterialFingerprint(FUtuPluginMaterial InUtuMaterial);
+	FString GetMaterialRedirect(FString InUnityRelativeFilename);
 
 public:
 	static TArray<FString> GetAllPropertiesAsString(UObject* Object);
@@ -475,6 +624,8 @@ private:
 
 	FLinearColor HexToColor(FString InHex);
 	UTexture2D* GetTextureFromUnityRelativeFilename(FString InUnityRelativeFilename);
+	UTexture2D* GetFallbackTexture();
+	UTexture2D* GetVirtualFallbackTexture();
 	UMaterialExpressionTextureSampleParameter2D* GetOrCreateTextureParameter(UMaterial* InMaterial, UTexture* InTexture, FName InParamName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
 	UMaterialExpressionScalarParameter* GetOrCreateScalarParameter(UMaterial* InMaterial, float InValue, FName InParamName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
 	UMaterialExpressionVectorParameter* GetOrCreateVectorParameter(UMaterial* InMaterial, FLinearColor InColor, FName InParamName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
@@ -482,15 +633,33 @@ private:
 	UMaterialExpressionMultiply* GetOrCreateMultiplyExpression(UMaterial* InMaterial, FString InExpressionName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
 	UMaterialExpressionPanner* GetOrCreatePannerExpression(UMaterial* InMaterial, FVector2D InValue, FString InExpressionName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
 	UMaterialExpressionTextureCoordinate* GetOrCreateTexCoordExpression(UMaterial* InMaterial, FVector2D InValue, FString InExpressionName, int InPosX, int InPosY, FUtuPluginMaterial InUtuMaterial);
+	UMaterialExpression* FindIndexedExpression(UMaterial* InMaterial, UClass* InClass, FString InName);
+	void AddIndexedExpression(UMaterial* InMaterial, UMaterialExpression* InExpression, FString InName);
+	void BuildExpressionIndex(UMaterial* InMaterial);
 
 	bool IsFbxExporter(FString Path);
 	FUtuPluginImportSettings_AllAssets GetAssetStruct(EUtuUnrealAssetType AssetType);
 
 private:
 	bool bWasInterchangeEnabled = true;
+	double ImportStartTime = 0.0;
+	bool bIsBatchSpawning = false;
+	TArray<AActor*> DeferredSpawnedActors; // Construction deferred until they are placed and parented
+	TArray<AActor*> BatchSpawnedActors; // Components registered once the scene is spawned
+	TArray<TWeakObjectPtr<UMaterialInterface>> DeferredMaterials; // Parents are always added before their instances
+	TSet<TWeakObjectPtr<UMaterialInterface>> DeferredMaterialsSet; // Membership of DeferredMaterials
+	UMaterial* ExpressionIndexMaterial = nullptr;
+	TMap<FString, UMaterialExpression*> ExpressionIndex; // "Class|ParameterName or Desc" -> expression of ExpressionIndexMaterial
+	TMap<FString, FString> OrmTextures; // Unity material -> packed ORM texture
+	TSet<FString> UnpaddableTextures;
+	TMap<FString, bool> PrefabsHaveStaticChild; // Unity prefab -> has_any_static_child of its first pass // Unity textures used by at least one material that would sample their padding
+	TMap<UMaterial*, UMaterial*> OrmParentMaterials; // Shipped parent -> ORM variant, nullptr if it can't be packed
+	TMap<FString, UMaterial*> VirtualParentMaterials; // Variant name -> parent with virtual samplers, nullptr if nothing to convert
+	TMap<FString, FString> MaterialRedirects; // Unity material -> Unity material sharing the same fingerprint
 
 public:
 	FAssetToolsModule* AssetTools;
+	TSharedPtr<FUtuPluginImportCache> ImportCache; // Shared with the other processors of the same import
 	// Global
 	FUtuPluginJson json;
 	EUtuAssetType assetType;
@@ -0,0 +1,84 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "UtuPlugin/Scripts/Public/UtuPluginJson.h"
+
+#include "CoreMinimal.h"
+#include "Runtime/Engine/Classes/Kismet/BlueprintFunctionLibrary.h"
+#include "Commandlets/Commandlet.h"
+#include "UtuPluginBenchmark.generated.h"
+
+USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+struct UTUPLUGIN_API FUtuPluginSyntheticExportSettings
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString ExportName = "UtuSynthetic";
+	// Quantities
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int SceneCount = 1;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ActorsPerScene = 200;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int PrefabCount = 20;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ComponentsPerPrefab = 4;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int MeshCount = 20;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int MaterialCount = 40;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int TextureCount = 40;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int TextureSize = 512;
+	// Same seed, same export
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int Seed = 0;
+};
+
+USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+struct UTUPLUGIN_API FUtuPluginBenchmarkPhase
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString Phase = "";
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int AssetCount = 0;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float Seconds = 0.0f;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float AssetsPerSecond = 0.0f;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float PeakUsedMemoryMB = 0.0f;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float UsedMemoryDeltaMB = 0.0f;
+};
+
+UCLASS()
+class UTUPLUGIN_API UUtuPluginBenchmark : public UBlueprintFunctionLibrary {
+	GENERATED_BODY()
+public:
+	// Writes a UtuPlugin.json export that only references files generated from the plugin content. Returns the json file fullname.
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static FString GenerateSyntheticExport(FUtuPluginSyntheticExportSettings Settings);
+	// Imports the export on the same frame and appends the per phase results to 'UnrealBenchmark.csv' next to the json.
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static TArray<FUtuPluginBenchmarkPhase> RunImportBenchmark(FString JsonFile);
+
+private:
+	static TArray<FString> ExportDefaultMeshesToFbx(FString InFolder);
+	static bool WriteSyntheticTexture(FString InFilename, int InSize, int InIndex, int InSeed);
+	static FUtuPluginActor MakeSyntheticActor(int InId, FString InName, FVector InLocation);
+};
+
+// UnrealEditor-Cmd <Project> -run=UtuPluginBenchmark [-Json=<UtuPlugin.json>] [-Scenes=1 -Actors=200 -Prefabs=20 -Components=4 -Meshes=20 -Materials=40 -Textures=40 -TextureSize=512 -Seed=0] -unattended -nullrhi
+UCLASS()
+class UTUPLUGIN_API UUtuPluginBenchmarkCommandlet : public UCommandlet {
+	GENERATED_BODY()
+public:
+	UUtuPluginBenchmarkCommandlet();
+	virtual int32 Main(const FString& Params) override;
+};
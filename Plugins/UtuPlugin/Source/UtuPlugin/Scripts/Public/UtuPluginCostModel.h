@@ -0,0 +1,46 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginJson.h"
+
+// Seconds = Base + PerUnit * Units, fitted per asset type from the timings of the previous imports of the project
+struct FUtuPluginCostFit {
+	double Count = 0.0;
+	double SumUnits = 0.0;
+	double SumSeconds = 0.0;
+	double SumUnitsSquared = 0.0;
+	double SumUnitsSeconds = 0.0;
+	double DefaultBase = 0.0;
+	double DefaultPerUnit = 0.0;
+
+	void AddSample(double Units, double Seconds);
+	double Estimate(double Units) const;
+};
+
+// Estimates the work of each asset from the export metadata, for weighted progress, ETA and the tick time budget
+// Units: Textures, Meshes and Animations = source file MB, Materials = parameter count, Prefabs Second Pass = component count, Scenes = actor count
+class UTUPLUGIN_API UtuPluginCostModel {
+public:
+	static double GetAssetUnits(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index);
+	static int64 GetAssetSourceBytes(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index); // 0 if the asset has no source file
+	static double EstimateSeconds(EUtuAssetType AssetType, double Units);
+
+	// Import
+	static void BeginImport(const FUtuPluginJson& Json, TArray<EUtuAssetType> AssetTypes);
+	static void CompleteAsset(EUtuAssetType AssetType, double Units, double Seconds);
+	static void CompleteImport();
+	static float GetWeightedProgress();
+	static float GetEtaSeconds(double ElapsedSeconds);
+
+private:
+	static void Load();
+	static void Save();
+	static FString GetCostModelFilename();
+
+	static bool bIsLoaded;
+	static FUtuPluginCostFit Fits[(int32)EUtuAssetType::PrefabSecondPass + 1];
+	static double TotalEstimatedSeconds;
+	static double DoneEstimatedSeconds;
+};
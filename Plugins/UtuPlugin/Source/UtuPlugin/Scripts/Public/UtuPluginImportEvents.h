@@ -0,0 +1,98 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "UtuPluginImportEvents.generated.h"
+
+struct FUtuPluginAssetEvent;
+
+// Small enough to be copied every frame by the UI
+USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+struct UTUPLUGIN_API FUtuPluginImportProgress
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bIsImporting = false;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	bool bWasCancelled = false;
+	// Phases
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString Phase = "";
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int PhaseIndex = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int PhaseCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float PhasePercent = 0.0f;
+	// Assets
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString LastAsset = "";
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int PhaseAssetsProcessed = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int PhaseAssetCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int AssetsProcessed = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int AssetCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float Percent = 0.0f;
+	// Percent of the estimated work, see UtuPluginCostModel
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float WeightedPercent = 0.0f;
+	// Log summary
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int WarningCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ErrorCount = 0;
+	// Time
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float ElapsedSeconds = 0.0f;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float EtaSeconds = -1.0f; // -1 until the first asset is done
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUtuOnImportStarted, const FUtuPluginImportProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUtuOnImportPhaseStarted, const FUtuPluginImportProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUtuOnImportPhaseCompleted, const FUtuPluginImportProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FUtuOnImportAssetCompleted, const FUtuPluginImportProgress&, Progress, const FString&, UnrealPath, const FString&, Outcome, float, Seconds);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUtuOnImportCompleted, const FUtuPluginImportProgress&, Progress);
+
+// Pushes the import progress to the UI instead of having it poll a copy of the whole import
+UCLASS()
+class UTUPLUGIN_API UUtuPluginImportEvents : public UEditorSubsystem {
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintAssignable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuOnImportStarted OnImportStarted;
+	UPROPERTY(BlueprintAssignable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuOnImportPhaseStarted OnPhaseStarted;
+	UPROPERTY(BlueprintAssignable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuOnImportPhaseCompleted OnPhaseCompleted;
+	UPROPERTY(BlueprintAssignable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuOnImportAssetCompleted OnAssetCompleted;
+	// Also broadcasted on cancel, see bWasCancelled
+	UPROPERTY(BlueprintAssignable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuOnImportCompleted OnImportCompleted;
+
+	UFUNCTION(BlueprintPure, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FUtuPluginImportProgress GetProgressSnapshot() const;
+
+	static UUtuPluginImportEvents* Get();
+
+	// Called by the import
+	static void NotifyImportStarted(int PhaseCount, int AssetCount);
+	static void NotifyPhaseStarted(FString Phase, int PhaseAssetCount);
+	static void NotifyPhaseCompleted();
+	static void NotifyAssetCompleted(const FUtuPluginAssetEvent& Event, double Seconds);
+	static void NotifyImportCompleted(bool bWasCancelled);
+
+private:
+	void UpdateTimeAndLog();
+
+	FUtuPluginImportProgress Progress;
+	double ImportStartTime = 0.0;
+};
@@ -5,8 +5,16 @@
 #include "CoreMinimal.h"
 #include "Runtime/Engine/Classes/Kismet/BlueprintFunctionLibrary.h"
 #include "Misc/OutputDevice.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginProfiling.h"
 #include "UtuPluginLog.generated.h"
 
+class FEvent;
+class FRunnableThread;
+class IFileHandle;
+
 DECLARE_LOG_CATEGORY_EXTERN(UTU, All, All);
 
 UENUM(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
@@ -22,19 +30,96 @@ public:
 		FString Message = "";
 	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 		EUtuLog LogCategory = EUtuLog::Log;
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		int Index = 0; // Position since the beginning of the log, stays valid once older messages are dropped
+	UPROPERTY(BlueprintReadWrite, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		FString Asset = ""; // Unreal path of the asset being processed when the message was logged
+};
+
+enum class EUtuLogFile : uint8 {
+	Import, Unreal, Events, Count
+};
+
+enum class EUtuEventStage : uint8 {
+	Lookup, Import, PostEdit, Count
+};
+
+// One line of the json event stream, collected while an asset is processed
+struct FUtuPluginAssetEvent {
+	bool bActive = false;
+	FString AssetType = "";
+	FString UnityPath = "";
+	FString UnrealPath = "";
+	FString Outcome = "";
+	double StartTime = 0.0;
+	double StageTimes[(int32)EUtuEventStage::Count] = {};
+	int WarningCount = 0;
+	int ErrorCount = 0;
+	TArray<FString> Messages; // Warnings and errors only
+
+	FString GetOutcome() const { return ErrorCount > 0 ? FString("Failed") : Outcome != "" ? Outcome : FString("Processed"); }
+};
+
+// Adds the time spent in its scope to a stage of the current asset event
+struct FUtuPluginEventStageTimer {
+	FUtuPluginEventStageTimer(EUtuEventStage InStage);
+	~FUtuPluginEventStageTimer();
+	EUtuEventStage Stage;
+	double StartTime;
+};
+
+// Appends the log files from a background thread so the game thread never waits on disk
+class FUtuPluginLogWriter : public FRunnable
+{
+public:
+	FUtuPluginLogWriter(FString ImportLogPath, FString UnrealLogPath, FString EventsPath);
+	virtual ~FUtuPluginLogWriter();
+
+	void Write(EUtuLogFile File, FString Text);
+	void Flush(bool bFromCrash = false);
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void WritePending();
+
+	struct FEntry {
+		EUtuLogFile File;
+		FString Text;
+	};
+	TQueue<FEntry, EQueueMode::Mpsc> Queue;
+	TArray<IFileHandle*> Files;
+	FCriticalSection WriteCritical; // Serializes the consumers of the queue (writer thread, flushes)
+	FEvent* WakeUpEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FThreadSafeBool bStopping = false;
+	int32 PendingCount = 0; // Only used without a writer thread
 };
 
 class StringOutputDevice : public FOutputDevice
 {
 public:
+	StringOutputDevice();
+
 	void RegisterToLog();
 	void UnregisterFromLog();
+	void FlushChunk(bool bFromCrash = false);
 
-	FString MyLog = "";
 	bool bIsRegistered = false;
+	// Capture
+	TSet<FName> ExcludedCategories;
+	ELogVerbosity::Type MaxVerbosity = ELogVerbosity::Log;
+	int32 ChunkSize = 64 * 1024; // Characters buffered before being handed to the log writer
+	int64 MaxCapturedSize = 256 * 1024 * 1024; // Characters, per import
 protected:
 	virtual void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const class FName& Category) override;
 
+private:
+	FCriticalSection ChunkCritical;
+	FString Chunk = "";
+	int64 CapturedSize = 0;
+
 };
 
 UCLASS()
@@ -59,18 +144,43 @@ public:
 		static void AddToLog(FString Message, EUtuLog LogCategory);
 	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
 		static void OpenDirectoryInWindowsExplorer(FString Path);
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static TArray<FUtuLog> GetLogPage(int PageIndex, int PageSize, bool bIncludeLogs, bool bIncludeWarnings, bool bIncludeErrors, FString AssetFilter, int& OutMatchingCount);
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static void GetLogCounters(int& OutLogCount, int& OutWarningCount, int& OutErrorCount, int& OutDroppedCount);
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static void SetLogContext(FString Asset);
 
 	static void PrintIntoLogFile(FString Message, bool bForceWrite);
+	static void PrintIntoUnrealLogFile(FString Message);
+	static void FlushLogFiles();
+	static void ShutdownLogWriter();
+
+	// Json event stream
+	static void BeginAssetEvent(FString AssetType, FString UnityPath, FString UnrealPath);
+	static void SetAssetEventOutcome(FString Outcome);
+	static void AddEventStageTime(EUtuEventStage Stage, double Seconds);
+	static void EndAssetEvent();
+	static void AddSaveEvent(int PackageCount, double Seconds);
 
 	static FString Timestamp;
 private:
-	static TArray<FUtuLog> Log;
-	static FString LogString;
+	static const FUtuLog& GetLogAt(int OrderIndex);
+
+	static const int LogCapacity = 50000; // Older messages are still in the log file
+	static TArray<FUtuLog> Log; // Ring buffer
+	static int LogTotal;
+	static FString LogString; // Joined messages of the ring buffer, appended as they come
+	static int LogStringStart; // Characters of LogString belonging to dropped messages
+	static FString LogContext;
+	static int LogCount;
 	static int ErrorCount;
 	static int WarningCount;
 	static EUtuLog LogState;
 	static StringOutputDevice* OutputDevice;
 	static FString LogFilePath;
+	static TUniquePtr<FUtuPluginLogWriter> LogWriter;
+	static FUtuPluginAssetEvent CurrentEvent;
 };
 
 
@@ -82,4 +192,5 @@ private:
 #define UTU_LOG_CLEAR() {UUtuPluginLog::ClearLog();}
 #define UTU_LOG_EMPTY_LINE() {UUtuPluginLog::AddToLog("", EUtuLog::Log);}
 #define UTU_LOG_SEPARATOR_LINE() {UTU_LOG_EMPTY_LINE();UUtuPluginLog::AddToLog("---------------------------------------------------------", EUtuLog::Log);UTU_LOG_EMPTY_LINE();}
+#define UTU_EVENT_STAGE(Stage, ...) {UTU_TRACE_SCOPE(#__VA_ARGS__); FUtuPluginEventStageTimer StageTimer(Stage); __VA_ARGS__;}
 #define UTU_LOG_SEMI_SEPARATOR_LINE() {UUtuPluginLog::AddToLog("----------------------------", EUtuLog::Log);}
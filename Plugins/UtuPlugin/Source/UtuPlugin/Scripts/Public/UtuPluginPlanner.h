@@ -0,0 +1,78 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "UtuPlugin/Scripts/Public/UtuPluginJson.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginAssets.h"
+
+#include "CoreMinimal.h"
+#include "Runtime/Engine/Classes/Kismet/BlueprintFunctionLibrary.h"
+#include "UtuPluginPlanner.generated.h"
+
+UENUM(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+enum class EUtuPlanAction : uint8
+{
+	Create, Reimport, Update, Skip, Conflict
+};
+
+USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+struct UTUPLUGIN_API FUtuPluginPlanEntry
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	EUtuAssetType AssetType = EUtuAssetType::Texture;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString UnityPath = "";
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString UnrealPath = "";
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	EUtuPlanAction Action = EUtuPlanAction::Create;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	FString Reason = "";
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float EstimatedSeconds = 0.0f;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int64 SourceBytes = 0;
+};
+
+USTRUCT(BlueprintType, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+struct UTUPLUGIN_API FUtuPluginPlan
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	TArray<FUtuPluginPlanEntry> Entries;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int CreateCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ReimportCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int UpdateCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int SkipCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int ConflictCount = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float EstimatedSeconds = 0.0f;
+	// Source files to import, a rough lower bound of the disk size the import will need
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	int64 SourceBytes = 0;
+	UPROPERTY(BlueprintReadOnly, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+	float PlanningSeconds = 0.0f;
+};
+
+UCLASS()
+class UTUPLUGIN_API UUtuPluginPlanner : public UBlueprintFunctionLibrary {
+	GENERATED_BODY()
+public:
+	// Dry run: what an import with the current import settings would do to each asset. Nothing is created or loaded.
+	// Also writes the plan to 'UnrealImportPlan.csv' next to the json.
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Alex Quevillon Utu Plugin"), Category = "Alex Quevillon - Utu Plugin")
+		static FUtuPluginPlan PlanImport(FUtuPluginJson Json, TArray<EUtuAssetType> AssetTypes);
+
+private:
+	static FUtuPluginPlanEntry PlanAsset(const FUtuPluginJson& Json, EUtuAssetType AssetType, int Index, FString UnityPath, EUtuUnrealAssetType UnrealAssetType, FUtuPluginAssetTypeProcessor& Proc, const TMap<FName, FName>& ExistingAssets, TMap<FString, FString>& PlannedPaths);
+	static void AddEntry(FUtuPluginPlan& OutPlan, FUtuPluginPlanEntry Entry);
+	static void WritePlan(const FUtuPluginPlan& Plan, FString JsonFileFullname);
+};
@@ -0,0 +1,44 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Insights: enable with -trace=cpu,UtuPlugin
+UE_TRACE_CHANNEL_EXTERN(UtuPluginChannel, UTUPLUGIN_API);
+#define UTU_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, UtuPluginChannel)
+
+// Stats: 'stat UtuPlugin'
+DECLARE_STATS_GROUP(TEXT("UtuPlugin"), STATGROUP_UtuPlugin, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Processed"), STAT_UtuPlugin_AssetsProcessed, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Textures Per Second"), STAT_UtuPlugin_TexturesPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Materials Per Second"), STAT_UtuPlugin_MaterialsPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Meshes Per Second"), STAT_UtuPlugin_MeshesPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Animations Per Second"), STAT_UtuPlugin_AnimationsPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Prefabs Per Second"), STAT_UtuPlugin_PrefabsPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Scenes Per Second"), STAT_UtuPlugin_ScenesPerSecond, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Texture Cache Hit Rate (%)"), STAT_UtuPlugin_TextureCacheHitRate, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Expression Index Hit Rate (%)"), STAT_UtuPlugin_ExpressionIndexHitRate, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Packages Dirtied"), STAT_UtuPlugin_PackagesDirtied, STATGROUP_UtuPlugin, UTUPLUGIN_API);
+
+class UTUPLUGIN_API UtuPluginProfiling {
+public:
+	static void BeginImport();
+	static void CompleteImport();
+	static void RecordTextureCacheLookup(bool bHit);
+	static void RecordExpressionIndexLookup(bool bHit);
+	static float GetTextureCacheHitRate();
+	static float GetExpressionIndexHitRate();
+
+private:
+	static void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+
+	static FDelegateHandle PackageMarkedDirtyHandle;
+	static int TextureCacheLookups;
+	static int TextureCacheHits;
+	static int ExpressionIndexLookups;
+	static int ExpressionIndexHits;
+};
@@ -0,0 +1,45 @@
+// Copyright Alex Quevillon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UtuPlugin/Scripts/Public/UtuPluginLog.h"
+
+// Timings of a processed asset, kept until the end of the import for the report
+struct FUtuPluginReportAsset {
+	FString Phase = "";
+	FString AssetType = "";
+	FString UnrealPath = "";
+	FString Outcome = "";
+	double Seconds = 0.0;
+	double StageTimes[(int32)EUtuEventStage::Count] = {};
+};
+
+struct FUtuPluginReportPhase {
+	FString Phase = "";
+	double StartTime = 0.0;
+	double Seconds = 0.0;
+	int AssetCount = 0;
+	double StageTimes[(int32)EUtuEventStage::Count] = {};
+	double SaveSeconds = 0.0;
+	uint64 PeakUsedPhysical = 0;
+};
+
+// Post-import performance report: 'UnrealImportReport.html' and 'UnrealImportReport.csv' next to the import log
+class UTUPLUGIN_API UtuPluginReport {
+public:
+	static void BeginImport();
+	static void BeginPhase(FString Phase);
+	static void AddAsset(const FUtuPluginAssetEvent& Event, double Seconds);
+	static void AddSave(double Seconds);
+	static void SampleMemory();
+	static void WriteReport(FString Folder, int SlowestAssetCount);
+
+private:
+	static void EndPhase();
+	static FString Escape(FString InText);
+
+	static TArray<FUtuPluginReportAsset> Assets;
+	static TArray<FUtuPluginReportPhase> Phases;
+	static double ImportStartTime;
+};